@@ -0,0 +1,69 @@
+#include "Bench.h"
+#include "Core/ArmorCurve.h"
+#include "Core/CombatRules.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+void RunArmorCurveBench()
+{
+    Bench::Header("armor curve: hard coded vs compiled table");
+
+    // vanilla resistances the engine hands over for 0..1500 armor rating at the default factor
+    constexpr float                       factor = 0.12f;
+    std::mt19937                          rng(7);
+    std::uniform_real_distribution<float> vanilla(0.0f, 1.8f);
+    std::vector<float>                    samples(4096);
+    for (auto& sample : samples) {
+        sample = vanilla(rng);
+    }
+    constexpr auto mask = 4096 - 1;
+
+    const Core::ArmorCurve defaults;
+    float                  worst = 0.0f;
+    for (int i = 0; i <= 20000; ++i) {
+        const float v = static_cast<float>(i) * 0.0001f;
+        worst         = std::max(worst, std::fabs(defaults.Evaluate(v, factor) - Core::AdjustArmorRating(v, factor)));
+    }
+    std::printf("  %-44s %12.2e %s\n", "default curve, max difference", worst, worst < 1e-5f ? "ok" : "WRONG");
+
+    std::vector<Core::ArmorCurvePoint> points;
+    const bool parsed = Core::ArmorCurve::Parse("250:0.5, 600:0.8, 1000:0.85, 1500:0.9", points) && points.size() == 4 &&
+                        !Core::ArmorCurve::Parse("250:0.5,oops", points) && points.size() == 4;
+    std::printf("  %-44s %12s\n", "parse (four points, garbage rejected)", parsed ? "ok" : "WRONG");
+    const auto custom = Core::ArmorCurve::Compile(points);
+
+    std::vector<float> out(samples.size());
+    std::vector<float> batch(samples.size());
+    defaults.Evaluate(samples, factor, batch);
+    bool same = true;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        same = same && batch[i] == defaults.Evaluate(samples[i], factor);
+    }
+    std::printf("  %-44s %12s\n", "batch matches per call evaluation", same ? "ok" : "WRONG");
+
+    Bench::Run("hard coded AdjustArmorRating", 10'000'000, [&](std::uint64_t i) {
+        Bench::DoNotOptimize(Core::AdjustArmorRating(samples[i & mask], factor));
+    });
+    Bench::Run("table, default curve", 10'000'000, [&](std::uint64_t i) {
+        Bench::DoNotOptimize(defaults.Evaluate(samples[i & mask], factor));
+    });
+    Bench::Run("table, four point curve", 10'000'000, [&](std::uint64_t i) {
+        Bench::DoNotOptimize(custom.Evaluate(samples[i & mask], factor));
+    });
+
+    // per armor piece cost of rating a 4096 item inventory
+    const double loop = Bench::Run("hard coded, 4096 item list", 2'000, [&](std::uint64_t) {
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            out[i] = Core::AdjustArmorRating(samples[i], factor);
+        }
+        Bench::DoNotOptimize(out.data());
+    });
+    const double table = Bench::Run("table batch, 4096 item list", 2'000, [&](std::uint64_t) {
+        defaults.Evaluate(samples, factor, out);
+        Bench::DoNotOptimize(out.data());
+    });
+    std::printf("  %-44s %9.2f / %.2f ns per item\n", "list, hard coded / table batch", loop / samples.size(), table / samples.size());
+}
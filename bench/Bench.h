@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Minimal host-side microbenchmark helpers. No framework on purpose, the numbers only need to be
+// comparable between two implementations measured in the same run.
+namespace Bench
+{
+    template <typename T>
+    inline void DoNotOptimize(const T& a_value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&a_value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &a_value;
+#endif
+    }
+
+    inline void Header(const char* a_title)
+    {
+        std::printf("\n== %s ==\n", a_title);
+    }
+
+    // Runs a_func a_iterations times and prints the mean cost of one call
+    template <typename F>
+    inline double Run(const char* a_name, std::uint64_t a_iterations, F&& a_func)
+    {
+        using clock = std::chrono::steady_clock;
+
+        // warm up caches and branch predictors
+        for (std::uint64_t i = 0; i < a_iterations / 10 + 1; ++i) {
+            a_func(i);
+        }
+
+        const auto start = clock::now();
+        for (std::uint64_t i = 0; i < a_iterations; ++i) {
+            a_func(i);
+        }
+        const auto   elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        const double perCall = elapsed / static_cast<double>(a_iterations);
+
+        std::printf("  %-44s %12.2f ns/op  (%llu ops)\n", a_name, perCall, static_cast<unsigned long long>(a_iterations));
+        return perCall;
+    }
+} // namespace Bench
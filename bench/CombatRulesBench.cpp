@@ -0,0 +1,47 @@
+#include "Bench.h"
+#include "Core/CombatRules.h"
+
+#include <array>
+
+void RunCombatRulesBench()
+{
+    Bench::Header("combat rules");
+
+    constexpr Core::BlockStaminaSettings       block{ 0.0f, 0.25f, 10.0f };
+    constexpr Core::BashStaminaSettings        bash{ 25.0f, 40.0f };
+    constexpr Core::PowerAttackStaminaSettings power{ 20.0f, 1.0f, 2.0f };
+    constexpr Core::PitFighterModifiers        pitFighter{ 1.15f, 1.3f, 1.5f };
+
+    std::array<float, 256> samples{};
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<float>(i) * 3.7f;
+    }
+    constexpr auto mask = samples.size() - 1;
+
+    Bench::Run("GetBlockStaminaDamage", 10'000'000, [&](std::uint64_t i) {
+        Core::BlockedHit hit{ 0.8f, samples[i & mask], 1.0f, (i & 1) != 0 };
+        Bench::DoNotOptimize(Core::GetBlockStaminaDamage(block, hit));
+    });
+
+    Bench::Run("GetBashStamina", 10'000'000, [&](std::uint64_t i) {
+        Core::BashAttack attack{ samples[i & mask], (i & 1) != 0, (i & 2) != 0 };
+        Bench::DoNotOptimize(Core::GetBashStamina(bash, attack));
+    });
+
+    Bench::Run("GetPowerAttackBaseStamina", 10'000'000, [&](std::uint64_t i) {
+        Bench::DoNotOptimize(Core::GetPowerAttackBaseStamina(power, samples[i & mask]));
+    });
+
+    Bench::Run("AdjustArmorRating", 10'000'000, [&](std::uint64_t i) {
+        Bench::DoNotOptimize(Core::AdjustArmorRating(samples[i & mask] * 0.004f, 0.12f));
+    });
+
+    Bench::Run("GetPitFighterMeleeMult", 10'000'000, [&](std::uint64_t i) {
+        Bench::DoNotOptimize(Core::GetPitFighterMeleeMult(pitFighter, static_cast<std::int32_t>(i & 7)));
+    });
+
+    Bench::Run("GetHitFrameStaminaCost", 10'000'000, [&](std::uint64_t i) {
+        auto weaponClass = static_cast<Core::WeaponClass>(i % 5);
+        Bench::DoNotOptimize(Core::GetHitFrameStaminaCost(weaponClass, (i & 8) != 0, (i & 16) != 0, 12.0));
+    });
+}
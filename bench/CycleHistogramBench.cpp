@@ -0,0 +1,47 @@
+#include "Bench.h"
+#include "Core/CycleHistogram.h"
+
+#include <random>
+#include <vector>
+
+void RunCycleHistogramBench()
+{
+    Bench::Header("hook profiler: scoped rdtsc timer overhead");
+
+    Core::CycleHistogram histogram;
+    std::uint64_t        work = 0;
+
+    const auto bare = Bench::Run("bare hook body", 10'000'000, [&](std::uint64_t i) {
+        work += i * 3;
+        Bench::DoNotOptimize(work);
+    });
+    const auto disabled = Bench::Run("scoped timer, profiler off", 10'000'000, [&](std::uint64_t i) {
+        Core::ScopedCycles scope(nullptr);
+        work += i * 3;
+        Bench::DoNotOptimize(work);
+    });
+    const auto enabled = Bench::Run("scoped timer, profiler on", 10'000'000, [&](std::uint64_t i) {
+        Core::ScopedCycles scope(&histogram);
+        work += i * 3;
+        Bench::DoNotOptimize(work);
+    });
+    std::printf("  %-44s %12.2f ns off, %.2f ns on\n", "added per hook call", disabled - bare, enabled - bare);
+    histogram.Drain();
+
+    // known distribution: 99 % around 1000 cycles, 1 % spikes around 50000
+    std::mt19937                                 rng(7);
+    std::uniform_int_distribution<std::uint64_t> fast(900, 1100);
+    std::uniform_int_distribution<std::uint64_t> slow(45'000, 55'000);
+    std::vector<std::uint64_t>                   samples;
+    for (int i = 0; i < 100'000; ++i) {
+        samples.push_back(i % 100 == 0 ? slow(rng) : fast(rng));
+    }
+    for (const auto sample : samples) {
+        histogram.Record(sample);
+    }
+
+    const auto summary = histogram.Drain();
+    std::printf("  %-44s %12.0f p50 %9.0f p99 %9llu max (expected ~1000 / ~1100 / <=55000)\n", "synthetic cycles", summary.p50, summary.p99,
+                static_cast<unsigned long long>(summary.max));
+    std::printf("  %-44s %12.2f cycles/ns\n", "tsc calibration", Core::CalibrateCyclesPerNs());
+}
@@ -0,0 +1,143 @@
+#include "Bench.h"
+#include "Core/HitDedupRing.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Hit
+    {
+        std::uint32_t cause;
+        std::uint32_t target;
+        std::uint32_t source;
+        std::uint32_t time;
+    };
+
+    // A recorded 200 actor battle at 60 fps: single swings, multi target cleaves and arrow volleys,
+    // and every so often the engine reporting the same hit twice in the same tick. Sources are the
+    // cause's weapon, or a spell cast next to it.
+    std::vector<Hit> MakeHitStream(std::size_t a_count, std::mt19937& a_rng)
+    {
+        std::uniform_int_distribution<std::uint32_t> actor(1, 200);
+        std::uniform_int_distribution<int>           kind(0, 9);
+        std::uniform_int_distribution<int>           burst(3, 8);
+        const auto weapon = [](std::uint32_t a_cause) { return 0x1000 + a_cause; };
+
+        std::vector<Hit> stream;
+        stream.reserve(a_count);
+        std::uint32_t time = 1000;
+        while (stream.size() < a_count) {
+            time += 16;
+            const auto cause = actor(a_rng);
+            switch (kind(a_rng)) {
+            case 0:
+            case 1: {
+                // cleave, one cause hits a handful of targets in the same tick
+                const auto targets = burst(a_rng);
+                for (int i = 0; i < targets; ++i) {
+                    stream.push_back({ cause, actor(a_rng), weapon(cause), time });
+                }
+            } break;
+            case 2: {
+                // arrow volley, many causes on one target spread over a few ticks
+                const auto target = actor(a_rng);
+                const auto arrows = burst(a_rng) * 2;
+                for (int i = 0; i < arrows; ++i) {
+                    const auto archer = actor(a_rng);
+                    stream.push_back({ archer, target, weapon(archer), time + static_cast<std::uint32_t>(i % 3) * 16 });
+                }
+            } break;
+            case 3: {
+                // duplicate report of the same swing
+                const auto target = actor(a_rng);
+                stream.push_back({ cause, target, weapon(cause), time });
+                stream.push_back({ cause, target, weapon(cause), time });
+            } break;
+            case 4: {
+                // weapon and spell landing in the same tick, two hits that must both count
+                const auto target = actor(a_rng);
+                stream.push_back({ cause, target, weapon(cause), time });
+                stream.push_back({ cause, target, 0x2000 + cause, time });
+            } break;
+            default:
+                stream.push_back({ cause, actor(a_rng), weapon(cause), time });
+                break;
+            }
+        }
+        stream.resize(a_count);
+        std::ranges::stable_sort(stream, {}, &Hit::time);
+        return stream;
+    }
+
+    // Reference model for the ring: every hit is stored under each time unit of its window in a
+    // multimap and looked up by exact time. Slow and obviously right, the ring has to agree with it.
+    class MultimapDedup
+    {
+    public:
+        bool CheckAndRecord(const Hit& a_hit, std::uint32_t a_window)
+        {
+            bool skip = false;
+            for (auto [it, end] = recent.equal_range(a_hit.time); it != end; ++it) {
+                if (it->second.cause == a_hit.cause && it->second.target == a_hit.target && it->second.source == a_hit.source) {
+                    skip = true;
+                    break;
+                }
+            }
+
+            const auto upper = recent.lower_bound(a_hit.time);
+            auto       it    = recent.begin();
+            while (it != upper) {
+                it = recent.erase(it);
+            }
+
+            if (!skip) {
+                for (std::uint32_t t = a_hit.time; t <= a_hit.time + a_window; ++t) {
+                    recent.emplace(t, a_hit);
+                }
+            }
+            return skip;
+        }
+
+    private:
+        std::multimap<std::uint32_t, Hit> recent;
+    };
+} // namespace
+
+void RunHitDedupBench()
+{
+    Bench::Header("hit dedup: ring vs multimap");
+
+    std::mt19937 rng(4321);
+    const auto   stream = MakeHitStream(1 << 16, rng);
+
+    for (const std::uint32_t window : { 0u, 16u }) {
+        MultimapDedup        reference;
+        Core::HitDedupRing<> ring;
+
+        std::size_t skipped    = 0;
+        std::size_t mismatches = 0;
+        for (const auto& hit : stream) {
+            const bool expected = reference.CheckAndRecord(hit, window);
+            mismatches += expected != ring.CheckAndRecord(hit.cause, hit.target, hit.source, hit.time, window);
+            skipped += expected;
+        }
+
+        std::printf("  -- window %u, %zu hits, %zu skipped%s\n", window, stream.size(), skipped, mismatches ? " (RESULTS DIFFER)" : "");
+
+        MultimapDedup mapReplay;
+        const auto    map = Bench::Run("multimap replay", stream.size() * 8, [&](std::uint64_t i) {
+            Bench::DoNotOptimize(mapReplay.CheckAndRecord(stream[i % stream.size()], window));
+        });
+
+        Core::HitDedupRing<> ringReplay;
+        const auto           fast = Bench::Run("ring replay", stream.size() * 8, [&](std::uint64_t i) {
+            const auto& hit = stream[i % stream.size()];
+            Bench::DoNotOptimize(ringReplay.CheckAndRecord(hit.cause, hit.target, hit.source, hit.time, window));
+        });
+
+        std::printf("  %-44s %12.2fx\n", "speedup", map / fast);
+    }
+}
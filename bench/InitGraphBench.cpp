@@ -0,0 +1,81 @@
+#include "Bench.h"
+#include "Core/InitGraph.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    using Affinity = Core::InitGraph::Affinity;
+
+    Core::InitGraph::Stage Sleep(int a_ms)
+    {
+        return [a_ms] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(a_ms));
+            return true;
+        };
+    }
+
+    double Since(std::chrono::steady_clock::time_point a_start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a_start).count();
+    }
+} // namespace
+
+void RunInitGraphBench()
+{
+    Bench::Header("init graph: plugin start up, stage costs simulated");
+
+    Core::WorkerPool pool(3);
+
+    // failures skip what comes after them, unknown names skip the stage, order follows the edges
+    {
+        Core::InitGraph  graph;
+        std::atomic<int> order{ 0 };
+        int              first = -1, second = -1;
+        bool             ranAfterFailure = false;
+        graph.Add("a", {}, Affinity::kWorker, [&] { first = order++; return true; });
+        graph.Add("b", { "a" }, Affinity::kCaller, [&] { second = order++; return true; });
+        graph.Add("broken", {}, Affinity::kCaller, [] { return false; });
+        graph.Add("after broken", { "broken", "a" }, Affinity::kWorker, [&] { ranAfterFailure = true; return true; });
+        graph.Add("typo", { "nope" }, Affinity::kCaller, [&] { ranAfterFailure = true; return true; });
+        std::atomic<int> skipped{ 0 };
+        const bool ok = graph.Run(pool, [&](const Core::InitGraph::StageReport& a_stage) { skipped += a_stage.result == Core::InitGraph::Result::kSkipped; });
+        const bool right = !ok && first == 0 && second == 1 && !ranAfterFailure && skipped == 2;
+        std::printf("  %-44s %12s\n", "order, failure and unknown name skip", right ? "ok" : "WRONG");
+    }
+
+    // the serial start up the plugin had: every stage in a row on the loading thread
+    const auto serialStart = std::chrono::steady_clock::now();
+    for (const int ms : { 2, 5, 3, 1, 1, 6, 1, 12, 4, 2, 1 }) {
+        Sleep(ms)();
+    }
+    const double serial = Since(serialStart);
+
+    const auto      graphStart = std::chrono::steady_clock::now();
+    Core::InitGraph load;
+    load.Add("address cache", {}, Affinity::kWorker, Sleep(2));
+    load.Add("settings", {}, Affinity::kWorker, Sleep(5));
+    load.Add("hooks", { "address cache", "settings" }, Affinity::kCaller, Sleep(3));
+    load.Add("pickpocket", { "hooks" }, Affinity::kCaller, Sleep(1));
+    load.Run(pool, {});
+
+    Core::InitGraph data;
+    data.Add("game settings", {}, Affinity::kCaller, Sleep(1));
+    data.Add("form manifest", { "game settings" }, Affinity::kCaller, Sleep(6));
+    data.Add("effect index", { "form manifest" }, Affinity::kCaller, Sleep(1));
+    data.Add("weapon records", {}, Affinity::kCaller, Sleep(12));
+    data.Add("stamina profiles", {}, Affinity::kWorker, Sleep(4));
+    data.Add("event sinks", { "form manifest", "effect index" }, Affinity::kCaller, Sleep(2));
+    data.Add("settings reload thread", { "event sinks" }, Affinity::kCaller, Sleep(1), true);
+    data.Run(pool, {});
+    const double blocking = Since(graphStart);
+    data.Wait();
+    const double total = Since(graphStart);
+
+    std::printf("  %-44s %12.2f ms\n", "serial", serial);
+    std::printf("  %-44s %12.2f ms\n", "graph, blocking the loading thread", blocking);
+    std::printf("  %-44s %12.2f ms\n", "graph, deferred stages included", total);
+    std::printf("  %-44s %12.2f ms of %.2f ms stage time\n", "data loaded graph wall time", data.WallMs(), data.StageMs());
+}
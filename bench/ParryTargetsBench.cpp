@@ -0,0 +1,48 @@
+#include "Bench.h"
+#include "Core/ParryTargets.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+void RunParryTargetsBench()
+{
+    Bench::Header("parry targets: 20 actor brawl");
+
+    // the player parrying in the middle of a brawl, 16 hostiles and 4 followers within fRangeActors
+    std::mt19937                          rng(99);
+    std::uniform_real_distribution<float> offset(-300.0f, 300.0f);
+    std::uniform_real_distribution<float> heading(0.0f, 6.2831853f);
+    std::vector<Core::ParryCandidate>     candidates;
+    for (int i = 0; i < 20; ++i) {
+        candidates.push_back({ offset(rng), offset(rng), i >= 4, i == 19 });
+    }
+
+    std::vector<std::uint32_t> targets;
+    const Core::ParryFilter    everyone{ 360.0f, 64, false };
+    const Core::ParryFilter    defaults{};
+    const Core::ParryFilter    cone{ 120.0f, 4, true };
+
+    // known geometry: straight ahead, behind and to the right of a player facing +y
+    const std::vector<Core::ParryCandidate> probe{ { 0.0f, 100.0f, true, false }, { 0.0f, -100.0f, true, false }, { 100.0f, 0.0f, true, false } };
+    Core::SelectParryTargets(probe, 0.0f, { 120.0f, 8, true }, targets);
+    const bool ahead = targets.size() == 1 && targets[0] == 0;
+    Core::SelectParryTargets(probe, 3.14159265f / 2.0f, { 120.0f, 8, true }, targets);
+    const bool right = targets.size() == 1 && targets[0] == 2;
+    std::printf("  %-44s %12s\n", "cone check (ahead, turned right)", ahead && right ? "ok" : "WRONG");
+
+    const auto passed = Core::SelectParryTargets(candidates, 0.0f, defaults, targets);
+    std::printf("  %-44s %12zu of %zu pass, %zu staggered\n", "default filter (hostile, cap 8)", passed, candidates.size(), targets.size());
+
+    float facing = 0.0f;
+    Bench::Run("select everyone (old behavior)", 1'000'000, [&](std::uint64_t) {
+        Bench::DoNotOptimize(Core::SelectParryTargets(candidates, facing, everyone, targets));
+    });
+    Bench::Run("select hostile, nearest 8", 1'000'000, [&](std::uint64_t) {
+        Bench::DoNotOptimize(Core::SelectParryTargets(candidates, facing, defaults, targets));
+    });
+    Bench::Run("select hostile, 120 degree cone, nearest 4", 1'000'000, [&](std::uint64_t i) {
+        facing = static_cast<float>(i & 63) * 0.1f;
+        Bench::DoNotOptimize(Core::SelectParryTargets(candidates, facing, cone, targets));
+    });
+}
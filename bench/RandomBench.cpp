@@ -0,0 +1,72 @@
+#include "Bench.h"
+#include "Core/Random.h"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace
+{
+    // Mirror of the old Conditions::GetRandomDouble: shared static engine, fresh distribution per call
+    double OldRandomDouble(double a_min, double a_max)
+    {
+        static std::random_device        rd;
+        static std::mt19937              gen(rd());
+        std::uniform_real_distribution<> distrib(a_min, a_max);
+        return distrib(gen);
+    }
+
+    int OldRandomInt(int a_min, int a_max)
+    {
+        static std::random_device          rd;
+        static std::mt19937                gen(rd());
+        std::uniform_int_distribution<int> distrib(a_min, a_max);
+        return distrib(gen);
+    }
+
+    // Mirror of the old Conditions::GetPointInRange
+    float OldPointInRange(double a_radius, float a_start)
+    {
+        float r     = a_radius * std::sqrt((float)OldRandomDouble(0.0f, 1.0f));
+        auto  theta = (float)OldRandomDouble(0.0f, 1.0f) * 2.0f * std::numbers::pi_v<float>;
+        return a_start + r * std::cos(theta);
+    }
+} // namespace
+
+void RunRandomBench()
+{
+    Bench::Header("random: xoshiro vs mt19937");
+
+    Core::SetRandomSeed(42);
+    auto& rng = Core::ThreadRng();
+
+    const auto oldDouble = Bench::Run("mt19937 GetRandomDouble", 10'000'000, [](std::uint64_t) { Bench::DoNotOptimize(OldRandomDouble(0.0, 1.0)); });
+    const auto newDouble = Bench::Run("xoshiro UniformDouble", 10'000'000, [&](std::uint64_t) { Bench::DoNotOptimize(rng.UniformDouble(0.0, 1.0)); });
+    std::printf("  %-44s %12.2fx\n", "speedup", oldDouble / newDouble);
+
+    const auto oldInt = Bench::Run("mt19937 GetRandomINT", 10'000'000, [](std::uint64_t) { Bench::DoNotOptimize(OldRandomInt(0, 800)); });
+    const auto newInt = Bench::Run("xoshiro UniformInt", 10'000'000, [&](std::uint64_t) { Bench::DoNotOptimize(rng.UniformInt(0, 800)); });
+    std::printf("  %-44s %12.2fx\n", "speedup", oldInt / newInt);
+
+    // one arrow rain landing point: the old path drew four doubles for x and y
+    const auto oldPoint = Bench::Run("mt19937 landing point (x + y)", 5'000'000, [](std::uint64_t) {
+        Bench::DoNotOptimize(OldPointInRange(800.0, 10.0f));
+        Bench::DoNotOptimize(OldPointInRange(800.0, 20.0f));
+    });
+    const auto newPoint = Bench::Run("xoshiro NextInDisc", 5'000'000, [&](std::uint64_t) { Bench::DoNotOptimize(rng.NextInDisc(800.0f)); });
+    std::printf("  %-44s %12.2fx\n", "speedup", oldPoint / newPoint);
+
+    std::array<Core::Rng::DiscPoint, 75> volley{};
+    Bench::Run("xoshiro FillDisc (75 arrow volley)", 200'000, [&](std::uint64_t) {
+        rng.FillDisc(volley, 800.0f);
+        Bench::DoNotOptimize(volley);
+    });
+
+    // deterministic seeding has to reproduce the same sequence
+    Core::SetRandomSeed(1234);
+    const auto first = Core::ThreadRng().Next();
+    Core::SetRandomSeed(1234);
+    const auto again = Core::ThreadRng().Next();
+    std::printf("  %-44s %12s\n", "seeded replay", first == again ? "same" : "DIFFERENT");
+}
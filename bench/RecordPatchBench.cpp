@@ -0,0 +1,93 @@
+#include "Bench.h"
+#include "Core/RecordPatcher.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Stand-in for the TESObjectWEAP fields the load time rules touch
+    struct MockWeapon
+    {
+        float stagger;
+        float reach;
+        float speed;
+        bool  nonPlayable;
+    };
+
+    std::vector<std::unique_ptr<MockWeapon>> MakeWeapons(std::size_t a_count)
+    {
+        std::mt19937                          rng(99);
+        std::uniform_real_distribution<float> value(0.5f, 1.5f);
+        std::uniform_int_distribution<int>    playable(0, 9);
+
+        std::vector<std::unique_ptr<MockWeapon>> weapons;
+        weapons.reserve(a_count);
+        for (std::size_t i = 0; i < a_count; ++i) {
+            weapons.push_back(std::make_unique<MockWeapon>(MockWeapon{ value(rng), value(rng), value(rng), playable(rng) == 0 }));
+        }
+        return weapons;
+    }
+
+    const Core::PatchRule<MockWeapon> rules[]{
+        { "zero stagger",
+          [](MockWeapon& a_weapon) {
+              if (a_weapon.nonPlayable) {
+                  return false;
+              }
+              a_weapon.stagger = 0.0f;
+              return true;
+          } },
+        { "clamp reach", [](MockWeapon& a_weapon) {
+             if (a_weapon.reach <= 1.3f) {
+                 return false;
+             }
+             a_weapon.reach = 1.3f;
+             return true;
+         } },
+    };
+} // namespace
+
+void RunRecordPatchBench()
+{
+    Bench::Header("record patcher: chunks on the worker pool vs serial loop");
+
+    // a large load order, vanilla has about 2700 weapon records
+    const auto                owned = MakeWeapons(200'000);
+    std::vector<MockWeapon*>  weapons;
+    for (const auto& weapon : owned) {
+        weapons.push_back(weapon.get());
+    }
+    weapons.push_back(nullptr);
+
+    const auto reset = [&] {
+        for (auto& weapon : owned) {
+            weapon->stagger = 1.0f;
+            weapon->reach   = 1.4f;
+        }
+    };
+
+    reset();
+    const auto    serialStart = std::chrono::steady_clock::now();
+    std::uint64_t expected    = 0;
+    for (auto weapon : weapons) {
+        for (const auto& rule : rules) {
+            expected += weapon && rule.apply(*weapon);
+        }
+    }
+    std::printf("  %-44s %12.3f ms wall\n", "serial loop", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - serialStart).count());
+
+    Core::WorkerPool pool(3);
+    for (auto* const workers : { static_cast<Core::WorkerPool*>(nullptr), &pool }) {
+        reset();
+        const auto report = Core::PatchRecords<MockWeapon>(weapons, rules, workers);
+
+        std::uint64_t patched = 0;
+        for (const auto& rule : report.rules) {
+            patched += rule.patched;
+            std::printf("  %-44s %12llu patched %9.3f ms\n", rule.name, static_cast<unsigned long long>(rule.patched), rule.ms);
+        }
+        std::printf("  %-44s %12.3f ms wall, %zu workers%s\n", "total", report.wallMs, report.workers, patched == expected ? "" : " (COUNTS DIFFER)");
+    }
+}
@@ -0,0 +1,95 @@
+#include "Bench.h"
+#include "Core/SpatialGrid.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct FakeActor
+    {
+        float x, y, z;
+        bool  dead;
+    };
+
+    // Battle around the origin: most actors packed in a brawl, the rest spread over the loaded cells
+    std::vector<FakeActor> MakeCrowd(std::size_t a_count, std::mt19937& a_rng)
+    {
+        std::normal_distribution<float>       brawl(0.0f, 600.0f);
+        std::uniform_real_distribution<float> cells(-8192.0f, 8192.0f);
+        std::uniform_real_distribution<float> height(-64.0f, 64.0f);
+
+        std::vector<FakeActor> crowd;
+        crowd.reserve(a_count);
+        for (std::size_t i = 0; i < a_count; ++i) {
+            const bool packed = i % 4 != 0;
+            crowd.push_back({ packed ? brawl(a_rng) : cells(a_rng), packed ? brawl(a_rng) : cells(a_rng), height(a_rng), i % 9 == 0 });
+        }
+        return crowd;
+    }
+
+    // Mirror of the old Conditions::NumNearbyActors: scan everyone, collect into a fresh vector, then count
+    std::int32_t ScanCount(const std::vector<FakeActor>& a_crowd, const FakeActor& a_origin, float a_radius)
+    {
+        const auto squaredRadius = a_radius * a_radius;
+
+        std::vector<const FakeActor*> result;
+        result.reserve(a_crowd.size());
+        for (const auto& actor : a_crowd) {
+            const auto dx = actor.x - a_origin.x;
+            const auto dy = actor.y - a_origin.y;
+            const auto dz = actor.z - a_origin.z;
+            if (&actor != &a_origin && dx * dx + dy * dy + dz * dz <= squaredRadius) {
+                result.push_back(&actor);
+            }
+        }
+
+        std::int32_t count = 0;
+        for (const auto* actor : result) {
+            if (!actor->dead) {
+                ++count;
+            }
+        }
+        return count;
+    }
+} // namespace
+
+void RunSpatialGridBench()
+{
+    Bench::Header("nearby actors: spatial grid vs linear scan");
+
+    std::mt19937 rng(1234);
+
+    for (const std::size_t crowdSize : { 20u, 60u, 200u, 1000u }) {
+        const auto crowd = MakeCrowd(crowdSize, rng);
+
+        Core::SpatialGrid<const FakeActor*> grid(500.0f);
+        const auto                          build = [&] {
+            grid.Clear();
+            for (const auto& actor : crowd) {
+                grid.Add(actor.x, actor.y, actor.z, &actor);
+            }
+            grid.Build();
+        };
+        build();
+
+        const auto gridCount = [&](const FakeActor& a_origin) {
+            return grid.CountWithin(a_origin.x, a_origin.y, a_origin.z, 500.0f, [&](const auto& a_entry) { return a_entry.value != &a_origin && !a_entry.value->dead; });
+        };
+
+        std::size_t mismatches = 0;
+        for (const auto& origin : crowd) {
+            mismatches += ScanCount(crowd, origin, 500.0f) != gridCount(origin);
+        }
+
+        std::printf("  -- %zu actors%s\n", crowdSize, mismatches ? " (RESULTS DIFFER)" : "");
+
+        const auto scan = Bench::Run("scan count r=500", 200'000, [&](std::uint64_t i) { Bench::DoNotOptimize(ScanCount(crowd, crowd[i % crowd.size()], 500.0f)); });
+
+        const auto query = Bench::Run("grid count r=500", 200'000, [&](std::uint64_t i) { Bench::DoNotOptimize(gridCount(crowd[i % crowd.size()])); });
+
+        Bench::Run("grid rebuild (once per frame)", 20'000, [&](std::uint64_t) { build(); });
+
+        std::printf("  %-44s %12.2fx\n", "query speedup", scan / query);
+    }
+}
@@ -0,0 +1,67 @@
+#include "Bench.h"
+#include "Core/UpdateTiers.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct MockActor
+    {
+        std::uint32_t formID;
+        float         distanceSquared;
+        bool          inCombat;
+    };
+} // namespace
+
+void RunUpdateTiersBench()
+{
+    Bench::Header("actor update tiers: 400 loaded actors");
+
+    // a busy city: 10 fighting near the player, the rest spread up to 8000 units out
+    std::mt19937                          rng(17);
+    std::uniform_real_distribution<float> distance(0.0f, 8000.0f);
+    std::vector<MockActor>                actors;
+    for (std::uint32_t i = 0; i < 400; ++i) {
+        const auto d = distance(rng);
+        actors.push_back({ 0xFF000800 + i, d * d, i < 10 });
+    }
+
+    const Core::UpdateTierSettings settings{};
+    Core::UpdateTierScheduler      scheduler;
+    std::uniform_int_distribution<int> changed(0, 999);
+
+    Core::UpdateTierCounts total{};
+    std::uint32_t          minMid = ~0u, maxMid = 0;
+    constexpr int          frames = 600;
+    for (int frame = 0; frame < frames; ++frame) {
+        for (const auto& actor : actors) {
+            const auto tier = Core::UpdateTierScheduler::Classify(settings, actor.distanceSquared, actor.inCombat);
+            scheduler.ShouldService(settings, tier, actor.formID, changed(rng) == 0);
+        }
+        scheduler.BeginFrame();
+        const auto& last = scheduler.LastFrame();
+        for (std::size_t i = 0; i < total.seen.size(); ++i) {
+            total.seen[i] += last.seen[i];
+            total.serviced[i] += last.serviced[i];
+        }
+        minMid = std::min(minMid, last.serviced[1]);
+        maxMid = std::max(maxMid, last.serviced[1]);
+    }
+
+    const char* names[] = { "near", "mid", "far" };
+    std::uint32_t serviced = 0;
+    for (std::size_t i = 0; i < total.seen.size(); ++i) {
+        std::printf("  %-44s %12.1f actors/frame, %.1f serviced\n", names[i], total.seen[i] / double(frames), total.serviced[i] / double(frames));
+        serviced += total.serviced[i];
+    }
+    std::printf("  %-44s %12u .. %u per frame\n", "mid tier spread", minMid, maxMid);
+    std::printf("  %-44s %12.1f of %zu per frame\n", "serviced in total", serviced / double(frames), actors.size());
+
+    Bench::Run("classify + schedule one actor", 10'000'000, [&](std::uint64_t i) {
+        const auto& actor = actors[i % actors.size()];
+        const auto  tier  = Core::UpdateTierScheduler::Classify(settings, actor.distanceSquared, actor.inCombat);
+        Bench::DoNotOptimize(scheduler.ShouldService(settings, tier, actor.formID, false));
+    });
+}
@@ -0,0 +1,86 @@
+#include "Bench.h"
+#include "Core/CommitQueue.h"
+#include "Core/Random.h"
+#include "Core/WorkerPool.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    struct Shot
+    {
+        float x, y, z;
+        float angleX, angleZ;
+    };
+
+    struct SolvedVolley
+    {
+        std::uint32_t     id;
+        std::vector<Shot> shots;
+    };
+
+    // the arrow rain solve: 75 landing points on a disc, pitch and heading from a common origin
+    SolvedVolley SolveVolley(std::uint32_t a_id)
+    {
+        std::vector<Core::Rng::DiscPoint> landing(75);
+        Core::ThreadRng().FillDisc(landing, 800.0f);
+
+        SolvedVolley volley{ a_id, {} };
+        volley.shots.reserve(landing.size());
+        for (const auto& point : landing) {
+            const float dx = point.x, dy = point.y, dz = -500.0f;
+            const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+            volley.shots.push_back({ 0.0f, 0.0f, 500.0f, -std::asin(dz / length), std::atan2(dx, dy) });
+        }
+        return volley;
+    }
+} // namespace
+
+void RunWorkerPoolBench()
+{
+    Bench::Header("worker pool + commit queue");
+
+    Core::CommitQueue<int> queue;
+    int                    sum = 0;
+    Bench::Run("commit queue push + drain", 1'000'000, [&](std::uint64_t i) {
+        queue.Push(static_cast<int>(i));
+        if ((i & 63) == 63) {
+            queue.Drain([&](int a_value) { sum += a_value; });
+        }
+    });
+    Bench::DoNotOptimize(sum);
+
+    // a burst of 64 volley solves landing on the main thread vs handed to the pool, the main
+    // thread only pays for submitting and later for committing
+    constexpr std::uint32_t          volleys = 64;
+    Core::CommitQueue<SolvedVolley>  solved;
+    std::size_t                      committed = 0;
+    using clock                                = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    for (std::uint32_t i = 0; i < volleys; ++i) {
+        solved.Push(SolveVolley(i));
+    }
+    committed += solved.Drain([](SolvedVolley& a_volley) { Bench::DoNotOptimize(a_volley.shots.data()); });
+    const auto inline_ = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    Core::WorkerPool pool(std::max(1u, std::thread::hardware_concurrency() - 1));
+    start = clock::now();
+    for (std::uint32_t i = 0; i < volleys; ++i) {
+        pool.Submit([i, &solved] { solved.Push(SolveVolley(i)); });
+    }
+    const auto submitted = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+    pool.WaitIdle();
+    const auto solvedAt = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+    start               = clock::now();
+    const auto drained  = solved.Drain([](SolvedVolley& a_volley) { Bench::DoNotOptimize(a_volley.shots.data()); });
+    const auto commit   = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+    committed += drained;
+
+    std::printf("  %-44s %12.1f us on the main thread\n", "64 volley solves inline", inline_);
+    std::printf("  %-44s %12.1f us submit + %.1f us commit (%zu workers, done after %.1f us)\n", "64 volley solves on the pool", submitted, commit,
+                pool.Size(), solvedAt);
+    std::printf("  %-44s %12zu of %u\n", "volleys committed", committed, volleys * 2);
+}
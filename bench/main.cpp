@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <cstring>
+
+void RunCombatRulesBench();
+void RunSpatialGridBench();
+void RunHitDedupBench();
+void RunRandomBench();
+void RunRecordPatchBench();
+void RunCycleHistogramBench();
+void RunParryTargetsBench();
+void RunUpdateTiersBench();
+void RunWorkerPoolBench();
+void RunArmorCurveBench();
+void RunInitGraphBench();
+
+int main(int argc, char** argv)
+{
+    // optional filter: paragon-bench <name>
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    const auto wants = [filter](const char* a_name) {
+        return !filter || std::strstr(a_name, filter) != nullptr;
+    };
+
+    if (wants("combat")) {
+        RunCombatRulesBench();
+    }
+    if (wants("spatial")) {
+        RunSpatialGridBench();
+    }
+    if (wants("hit dedup")) {
+        RunHitDedupBench();
+    }
+    if (wants("random")) {
+        RunRandomBench();
+    }
+    if (wants("record patcher")) {
+        RunRecordPatchBench();
+    }
+    if (wants("hook profiler")) {
+        RunCycleHistogramBench();
+    }
+    if (wants("parry")) {
+        RunParryTargetsBench();
+    }
+    if (wants("actor update")) {
+        RunUpdateTiersBench();
+    }
+    if (wants("worker pool")) {
+        RunWorkerPoolBench();
+    }
+    if (wants("armor")) {
+        RunArmorCurveBench();
+    }
+    if (wants("init graph")) {
+        RunInitGraphBench();
+    }
+
+    std::printf("\n");
+    return 0;
+}
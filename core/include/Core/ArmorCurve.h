@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+    // Armor rating curve as data, see ArmorRatingScaling::AdjustArmorRating. The engine hands over
+    // its vanilla damage resistance, armor rating = vanilla / fArmorScalingFactor * 100. At or below
+    // the first breakpoint the vanilla value passes through, from there on the resistance follows the
+    // breakpoints linearly and stays at the last one. The default reproduces the former hard coded
+    // curve (<= 500 vanilla, 0.75 at 500 rising to 0.90 at 1000 and above).
+    struct ArmorCurvePoint
+    {
+        float rating;
+        float resist;
+    };
+
+    inline constexpr std::array<ArmorCurvePoint, 2> defaultArmorCurve{ { { 500.0f, 0.75f }, { 1000.0f, 0.90f } } };
+
+    // Compiled once per settings load into a dense table over [first, last] breakpoint rating, an
+    // evaluation is a multiply-add, a clamp and one interpolated table read whatever the number of
+    // breakpoints. A breakpoint between two table nodes is smoothed over one node ((last - first) / 256
+    // rating), breakpoints on a line like the default ones come out exact. fArmorScalingFactor stays
+    // a per call argument, the engine value can change after the curve was compiled.
+    class ArmorCurve
+    {
+    public:
+        static constexpr std::size_t nodes = 257;
+
+        ArmorCurve() : ArmorCurve(Compile(defaultArmorCurve)) {}
+
+        // Points are sorted by rating, ratings <= 0 and resistances outside [0, 1] are dropped, no
+        // point left makes the curve a pass through
+        static ArmorCurve Compile(std::span<const ArmorCurvePoint> a_points);
+
+        // "500:0.75, 1000:0.90", false (and a_out untouched) on anything else
+        static bool Parse(std::string_view a_text, std::vector<ArmorCurvePoint>& a_out);
+
+        float Evaluate(float a_vanilla, float a_scalingFactor) const noexcept
+        {
+            const float position = a_vanilla * (invStep * 100.0f / a_scalingFactor) - first * invStep;
+            if (!(position > 0.0f)) {
+                return a_vanilla;
+            }
+            const float clamped = position < lastNode ? position : lastNode;
+            const auto  index   = static_cast<std::size_t>(clamped < lastNode - 1.0f ? clamped : lastNode - 1.0f);
+            const float t       = clamped - static_cast<float>(index);
+            return table[index] + (table[index + 1] - table[index]) * t;
+        }
+
+        // Same result as Evaluate() for every element, hoisting the division and written branch free
+        // so the compiler can vectorize it where it has gathers. For inventory and UI code rating a
+        // whole list of armor pieces at once.
+        void Evaluate(std::span<const float> a_vanilla, float a_scalingFactor, std::span<float> a_out) const noexcept;
+
+        bool operator==(const ArmorCurve&) const = default;
+
+    private:
+        struct PassThrough
+        {};
+
+        explicit ArmorCurve(PassThrough) noexcept {}
+
+        static constexpr float lastNode = static_cast<float>(nodes - 1);
+
+        // a pass through curve keeps invStep at 0, every position is then 0
+        float                    first{ 0.0f };
+        float                    invStep{ 0.0f };
+        std::array<float, nodes> table{};
+    };
+} // namespace Core
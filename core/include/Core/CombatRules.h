@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+
+// Engine-agnostic combat rules. Everything in here works on plain values so it can be built and
+// profiled on any host; the hooks in src/ only gather the inputs from the game and apply the result.
+namespace Core
+{
+    // Block stamina, see BashBlockStaminaPatch::GetStaminaDamage
+    struct BlockStaminaSettings
+    {
+        float staggerMult; // fStaminaBlockStaggerMult
+        float damageMult;  // fStaminaBlockDmgMult
+        float base;        // fStaminaBlockBase
+    };
+
+    struct BlockedHit
+    {
+        float percentBlocked;
+        float physicalDamage;
+        float stagger;
+        bool  hasBlockPerk;
+    };
+
+    float GetBlockStaminaDamage(const BlockStaminaSettings& a_settings, const BlockedHit& a_hit);
+
+    // Bash and power attack stamina, see BashBlockStaminaPatch::GetAttackStamina
+    struct BashStaminaSettings
+    {
+        float bashBase;      // fStaminaBashBase
+        float powerBashBase; // fStaminaPowerBashBase
+    };
+
+    struct BashAttack
+    {
+        float staminaMult;
+        bool  powerAttack;
+        bool  hasBashPerk;
+    };
+
+    float GetBashStamina(const BashStaminaSettings& a_settings, const BashAttack& a_attack);
+
+    struct PowerAttackStaminaSettings
+    {
+        float weaponBase;         // fStaminaAttackWeaponBase
+        float weaponMult;         // fStaminaAttackWeaponMult
+        float powerAttackPenalty; // fPowerAttackStaminaPenalty
+    };
+
+    // Cost before the kModPowerAttackStamina entry point and the attack data stamina mult are applied
+    float GetPowerAttackBaseStamina(const PowerAttackStaminaSettings& a_settings, float a_weaponWeight);
+
+    // The former hard coded armor rating curve, now the sArmorCurve default (see Core::ArmorCurve).
+    // Kept as the reference the armor curve bench measures against.
+    float AdjustArmorRating(float a_vanilla, float a_scalingFactor);
+
+    // Pit fighter damage multipliers, see Hooks::CombatHit/BowHit/AdjustActiveEffect
+    struct PitFighterModifiers
+    {
+        float minEnemy;
+        float midEnemy;
+        float maxEnemy;
+    };
+
+    // melee scales up with the number of enemies and does nothing when nobody is around
+    float GetPitFighterMeleeMult(const PitFighterModifiers& a_mods, std::int32_t a_enemies);
+    // bows and spells scale down with the number of enemies
+    float GetPitFighterRangedMult(const PitFighterModifiers& a_mods, std::int32_t a_enemies);
+
+    // HitFrame stamina drain, see AnimationGraphEventHandler::OnHitFrame
+    enum class WeaponClass : std::uint8_t
+    {
+        kOther,
+        kOneHanded, // sword, war axe, mace
+        kTwoHanded, // greatsword, battleaxe, warhammer
+        kDagger,
+        kHandToHand
+    };
+
+    // one table lookup times the stamina global, weapons outside the melee classes cost a flat 10.
+    // Only the player pays the dual wield modifier, npc costs are balanced around never having it.
+    double GetHitFrameStaminaCost(WeaponClass a_class, bool a_dualWielding, bool a_player, double a_global);
+} // namespace Core
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Core
+{
+    // Lock free multi producer, single consumer hand over of T values. Any thread Push()es with one
+    // compare exchange onto an intrusive stack, the consumer thread takes the whole stack with one
+    // exchange in Drain() and visits it in push order. Meant for results computed off the main
+    // thread that have to be applied on it at a fixed point of the frame.
+    template <typename T>
+    class CommitQueue
+    {
+    public:
+        CommitQueue() = default;
+        ~CommitQueue()
+        {
+            Drain([](T&) {});
+        }
+
+        CommitQueue(const CommitQueue&)            = delete;
+        CommitQueue& operator=(const CommitQueue&) = delete;
+
+        void Push(T a_value)
+        {
+            auto node = new Node{ std::move(a_value), head.load(std::memory_order_relaxed) };
+            while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        bool Empty() const noexcept { return head.load(std::memory_order_relaxed) == nullptr; }
+
+        // Consumer thread only. Values pushed while draining wait for the next call.
+        template <typename F>
+        std::size_t Drain(F&& a_func)
+        {
+            Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+            // the stack is newest first, reverse it to commit in push order
+            Node* ordered = nullptr;
+            while (node) {
+                auto next  = node->next;
+                node->next = ordered;
+                ordered    = node;
+                node       = next;
+            }
+
+            std::size_t count = 0;
+            while (ordered) {
+                auto next = ordered->next;
+                a_func(ordered->value);
+                delete ordered;
+                ordered = next;
+                count++;
+            }
+            return count;
+        }
+
+    private:
+        struct Node
+        {
+            T     value;
+            Node* next;
+        };
+
+        std::atomic<Node*> head{ nullptr };
+    };
+} // namespace Core
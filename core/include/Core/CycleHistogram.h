@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#else
+#    include <x86intrin.h>
+#endif
+
+namespace Core
+{
+    inline std::uint64_t ReadCycles() noexcept
+    {
+        return __rdtsc();
+    }
+
+    // TSC ticks per nanosecond, measured once against steady_clock over a_sample
+    inline double CalibrateCyclesPerNs(std::chrono::milliseconds a_sample = std::chrono::milliseconds(20))
+    {
+        const auto clockStart = std::chrono::steady_clock::now();
+        const auto tscStart   = ReadCycles();
+        std::this_thread::sleep_for(a_sample);
+        const auto tscEnd   = ReadCycles();
+        const auto elapsed  = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - clockStart).count();
+        return elapsed > 0.0 ? static_cast<double>(tscEnd - tscStart) / elapsed : 1.0;
+    }
+
+    // Lock free histogram of cycle counts, every power of two is split into four buckets so a
+    // percentile is off by at most 25 %. Record() is two relaxed atomic adds (plus a load for the
+    // max) so it can sit on hooks that run on several threads at once; Drain() hands back
+    // everything recorded since the previous Drain() and starts over.
+    class CycleHistogram
+    {
+    public:
+        static constexpr std::size_t bucketCount = 188; // up to 2^48 cycles
+
+        struct Summary
+        {
+            std::uint64_t count{ 0 };
+            std::uint64_t total{ 0 };
+            std::uint64_t max{ 0 };
+            double        p50{ 0.0 };
+            double        p99{ 0.0 };
+
+            double Mean() const noexcept { return count ? static_cast<double>(total) / static_cast<double>(count) : 0.0; }
+        };
+
+        void Record(std::uint64_t a_cycles) noexcept
+        {
+            buckets[BucketOf(a_cycles)].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(a_cycles, std::memory_order_relaxed);
+
+            auto seen = max.load(std::memory_order_relaxed);
+            while (a_cycles > seen && !max.compare_exchange_weak(seen, a_cycles, std::memory_order_relaxed)) {}
+        }
+
+        Summary Drain() noexcept
+        {
+            std::array<std::uint64_t, bucketCount> counts;
+            for (std::size_t i = 0; i < bucketCount; ++i) {
+                counts[i] = buckets[i].exchange(0, std::memory_order_relaxed);
+            }
+
+            Summary summary;
+            for (const auto c : counts) {
+                summary.count += c;
+            }
+            summary.total = total.exchange(0, std::memory_order_relaxed);
+            summary.max   = max.exchange(0, std::memory_order_relaxed);
+            summary.p50   = Percentile(counts, summary.count, 0.50);
+            summary.p99   = Percentile(counts, summary.count, 0.99);
+            return summary;
+        }
+
+    private:
+        static std::size_t BucketOf(std::uint64_t a_cycles) noexcept
+        {
+            if (a_cycles < 4) {
+                return static_cast<std::size_t>(a_cycles);
+            }
+            const auto exponent = static_cast<std::size_t>(std::bit_width(a_cycles)) - 1;
+            const auto sub      = static_cast<std::size_t>(a_cycles >> (exponent - 2)) & 3;
+            return std::min((exponent - 1) * 4 + sub, bucketCount - 1);
+        }
+
+        // [low, high) cycles covered by a bucket
+        static std::pair<double, double> BucketRange(std::size_t a_bucket) noexcept
+        {
+            if (a_bucket < 4) {
+                return { static_cast<double>(a_bucket), static_cast<double>(a_bucket + 1) };
+            }
+            const auto shift = a_bucket / 4 - 1;
+            const auto base  = static_cast<double>(std::uint64_t{ 1 } << shift);
+            return { static_cast<double>(4 + a_bucket % 4) * base, static_cast<double>(5 + a_bucket % 4) * base };
+        }
+
+        static double Percentile(const std::array<std::uint64_t, bucketCount>& a_counts, std::uint64_t a_samples, double a_fraction) noexcept
+        {
+            if (!a_samples) {
+                return 0.0;
+            }
+
+            const double  rank = a_fraction * static_cast<double>(a_samples);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucketCount; ++i) {
+                if (!a_counts[i]) {
+                    continue;
+                }
+                if (static_cast<double>(seen + a_counts[i]) >= rank) {
+                    const auto [low, high] = BucketRange(i);
+                    return low + (high - low) * ((rank - static_cast<double>(seen)) / static_cast<double>(a_counts[i]));
+                }
+                seen += a_counts[i];
+            }
+            return BucketRange(bucketCount - 1).second;
+        }
+
+        std::array<std::atomic<std::uint64_t>, bucketCount> buckets{};
+        std::atomic<std::uint64_t>                          total{ 0 };
+        std::atomic<std::uint64_t>                          max{ 0 };
+    };
+
+    // Times its own lifetime into a histogram, a null histogram costs one branch and no rdtsc
+    class ScopedCycles
+    {
+    public:
+        explicit ScopedCycles(CycleHistogram* a_histogram) noexcept : histogram(a_histogram), start(a_histogram ? ReadCycles() : 0) {}
+
+        ~ScopedCycles()
+        {
+            if (histogram) {
+                histogram->Record(ReadCycles() - start);
+            }
+        }
+
+        ScopedCycles(const ScopedCycles&)            = delete;
+        ScopedCycles& operator=(const ScopedCycles&) = delete;
+
+    private:
+        CycleHistogram* histogram;
+        std::uint64_t   start;
+    };
+} // namespace Core
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Core
+{
+    // Remembers the last Capacity (cause, target, source, time) hits so the same hit reported twice
+    // by the engine can be skipped. Entries live in flat arrays that are overwritten round robin, a check
+    // is one branchless pass over all of them which compilers turn into a few vector compares, and
+    // nothing is ever allocated or erased: an old entry simply stops matching once it falls out of
+    // the dedup window. Keys are opaque ids (actor and weapon/spell form ids in the plugin), 0 is
+    // never a cause.
+    template <std::size_t Capacity = 64>
+    class HitDedupRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    public:
+        using Key = std::uint32_t;
+
+        // Returns true when the same cause hit the same target with the same source within a_window
+        // time units before a_time, otherwise records the hit and returns false. Time is unsigned and may wrap, an
+        // entry stamped after a_time (clock reset on load) never matches.
+        bool CheckAndRecord(Key a_cause, Key a_target, Key a_source, std::uint32_t a_time, std::uint32_t a_window) noexcept
+        {
+            if (Contains(a_cause, a_target, a_source, a_time, a_window)) {
+                return true;
+            }
+            causes[head]  = a_cause;
+            targets[head] = a_target;
+            sources[head] = a_source;
+            times[head]   = a_time;
+            head          = (head + 1) & (Capacity - 1);
+            return false;
+        }
+
+        bool Contains(Key a_cause, Key a_target, Key a_source, std::uint32_t a_time, std::uint32_t a_window) const noexcept
+        {
+            std::uint32_t found = 0;
+            for (std::size_t i = 0; i < Capacity; ++i) {
+                const std::uint32_t sameKey  = ((causes[i] ^ a_cause) | (targets[i] ^ a_target) | (sources[i] ^ a_source)) == 0;
+                const std::uint32_t inWindow = a_time - times[i] <= a_window;
+                found |= sameKey & inWindow;
+            }
+            return found != 0;
+        }
+
+        void Clear() noexcept
+        {
+            causes.fill(0);
+            targets.fill(0);
+            sources.fill(0);
+            times.fill(0);
+            head = 0;
+        }
+
+    private:
+        std::array<Key, Capacity>           causes{};
+        std::array<Key, Capacity>           targets{};
+        std::array<Key, Capacity>           sources{};
+        std::array<std::uint32_t, Capacity> times{};
+        std::size_t                         head{ 0 };
+    };
+} // namespace Core
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "Core/WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Core
+{
+    // Start up work as a graph of named stages instead of one long serial function. A stage runs
+    // once every stage it was added after has succeeded; a failed stage (or a dependency name that
+    // was never added) skips everything after it. kWorker stages run on the worker pool next to each
+    // other and next to the caller, kCaller stages run on the thread calling Run()/Wait(), which is
+    // where anything touching hooks or event sources belongs.
+    // Deferred stages, and every stage after one, are not waited for by Run(): worker ones keep
+    // running in the background, caller ones are held back. Wait() finishes the graph, call it
+    // before anything needs the deferred results.
+    class InitGraph
+    {
+    public:
+        using Stage = std::function<bool()>;
+
+        enum class Affinity : std::uint8_t
+        {
+            kCaller,
+            kWorker
+        };
+
+        enum class Result : std::uint8_t
+        {
+            kOk,
+            kFailed,
+            kSkipped
+        };
+
+        struct StageReport
+        {
+            std::string_view name;
+            Result           result;
+            bool             worker;
+            double           startMs; // since the first Run()
+            double           ms;
+        };
+
+        using Report = std::function<void(const StageReport&)>;
+
+        // a_after must name stages added before this one
+        void Add(std::string a_name, std::initializer_list<std::string_view> a_after, Affinity a_affinity, Stage a_stage, bool a_deferred = false)
+        {
+            std::lock_guard lock(mutex);
+            const auto      index = stages.size();
+            auto&           stage = stages.emplace_back();
+            stage.name            = std::move(a_name);
+            stage.affinity        = a_affinity;
+            stage.run             = std::move(a_stage);
+            stage.deferred        = a_deferred;
+            for (const auto name : a_after) {
+                const auto dependency = std::ranges::find(stages.begin(), stages.end() - 1, name, &Node::name);
+                if (dependency == stages.end() - 1) {
+                    stage.broken = true;
+                    continue;
+                }
+                stage.deferred = stage.deferred || dependency->deferred;
+                stage.waitingFor++;
+                dependency->next.push_back(index);
+            }
+        }
+
+        // Runs every stage that is not deferred and returns once they are finished, false if one of
+        // them failed or was skipped. a_report is called from the thread that ran a stage (or
+        // finished the last dependency of a skipped one), possibly on several threads at once.
+        bool Run(WorkerPool& a_pool, Report a_report)
+        {
+            std::unique_lock lock(mutex);
+            pool   = &a_pool;
+            report = std::move(a_report);
+            start  = clock::now();
+            for (std::size_t i = 0; i < stages.size(); ++i) {
+                if (stages[i].state == State::kWaiting && stages[i].waitingFor == 0) {
+                    Ready(i, lock);
+                }
+            }
+            return Execute(lock, false);
+        }
+
+        // Finishes the deferred stages, true if every stage of the graph succeeded. Returns right
+        // away once everything ran, so it can be called on every path that needs the results.
+        bool Wait()
+        {
+            std::unique_lock lock(mutex);
+            return !pool || Execute(lock, true);
+        }
+
+        // Wall time from the first Run() to the last finished stage, and the summed stage times
+        double WallMs() const
+        {
+            std::lock_guard lock(mutex);
+            return wallMs;
+        }
+
+        double StageMs() const
+        {
+            std::lock_guard lock(mutex);
+            return stageMs;
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        enum class State : std::uint8_t
+        {
+            kWaiting,
+            kQueued,
+            kRunning,
+            kDone
+        };
+
+        struct Node
+        {
+            std::string              name;
+            Affinity                 affinity{ Affinity::kCaller };
+            Stage                    run;
+            bool                     deferred{ false };
+            bool                     broken{ false };
+            std::uint32_t            waitingFor{ 0 };
+            std::vector<std::size_t> next;
+            State                    state{ State::kWaiting };
+            Result                   result{ Result::kOk };
+        };
+
+        double Since(clock::time_point a_time) const { return std::chrono::duration<double, std::milli>(a_time - start).count(); }
+
+        bool Finished(bool a_all) const
+        {
+            return std::ranges::all_of(stages, [a_all](const Node& a_stage) { return (!a_all && a_stage.deferred) || a_stage.state == State::kDone; });
+        }
+
+        bool Succeeded(bool a_all) const
+        {
+            return std::ranges::all_of(stages, [a_all](const Node& a_stage) { return (!a_all && a_stage.deferred) || a_stage.result == Result::kOk; });
+        }
+
+        bool Execute(std::unique_lock<std::mutex>& a_lock, bool a_all)
+        {
+            for (;;) {
+                const auto caller = std::ranges::find_if(callerQueue, [&](std::size_t a_index) { return a_all || !stages[a_index].deferred; });
+                if (caller != callerQueue.end()) {
+                    const auto index = *caller;
+                    callerQueue.erase(caller);
+                    Start(index, a_lock);
+                    continue;
+                }
+                if (Finished(a_all)) {
+                    return Succeeded(a_all);
+                }
+                changed.wait(a_lock);
+            }
+        }
+
+        // Called with the lock held, the lock is released while the stage runs
+        void Start(std::size_t a_index, std::unique_lock<std::mutex>& a_lock)
+        {
+            auto& stage = stages[a_index];
+            stage.state = State::kRunning;
+            const auto worker = stage.affinity == Affinity::kWorker;
+
+            a_lock.unlock();
+            const auto began = clock::now();
+            const auto ok    = stage.run();
+            const auto ended = clock::now();
+            a_lock.lock();
+
+            Finish(a_index, ok ? Result::kOk : Result::kFailed, worker, began, ended, a_lock);
+        }
+
+        void Ready(std::size_t a_index, std::unique_lock<std::mutex>& a_lock)
+        {
+            auto& stage = stages[a_index];
+            if (stage.broken) {
+                const auto now = clock::now();
+                Finish(a_index, Result::kSkipped, false, now, now, a_lock);
+                return;
+            }
+            stage.state = State::kQueued;
+            if (stage.affinity == Affinity::kCaller) {
+                callerQueue.push_back(a_index);
+                changed.notify_all();
+                return;
+            }
+            pool->Submit([this, a_index] {
+                std::unique_lock lock(mutex);
+                Start(a_index, lock);
+            });
+        }
+
+        void Finish(std::size_t a_index, Result a_result, bool a_worker, clock::time_point a_began, clock::time_point a_ended,
+                    std::unique_lock<std::mutex>& a_lock)
+        {
+            auto&        stage = stages[a_index];
+            const double ms    = std::chrono::duration<double, std::milli>(a_ended - a_began).count();
+            stage.result       = a_result;
+            wallMs             = std::max(wallMs, Since(a_ended));
+            stageMs += ms;
+
+            // the stage only counts as done after its report, Wait() returning means every line is out
+            if (report) {
+                const StageReport line{ stage.name, a_result, a_worker, Since(a_began), ms };
+                a_lock.unlock();
+                report(line);
+                a_lock.lock();
+            }
+            stage.state = State::kDone;
+
+            for (const auto next : stage.next) {
+                auto& dependent  = stages[next];
+                dependent.broken = dependent.broken || a_result != Result::kOk;
+                if (--dependent.waitingFor == 0) {
+                    Ready(next, a_lock);
+                }
+            }
+            changed.notify_all();
+        }
+
+        mutable std::mutex      mutex;
+        std::condition_variable changed;
+        std::deque<Node>        stages;
+        std::deque<std::size_t> callerQueue;
+        WorkerPool*             pool{ nullptr };
+        Report                  report;
+        clock::time_point       start;
+        double                  wallMs{ 0.0 };
+        double                  stageMs{ 0.0 };
+    };
+} // namespace Core
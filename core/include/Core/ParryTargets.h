@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Core
+{
+    // An actor around the parrying actor, position relative to it in game units
+    struct ParryCandidate
+    {
+        float x;
+        float y;
+        bool  hostile;
+        bool  dead;
+    };
+
+    struct ParryFilter
+    {
+        float         coneDegrees{ 360.0f }; // full width of the cone around the facing, 360 takes everyone
+        std::uint32_t maxTargets{ 8 };       // nearest ones win, 0 takes no one
+        bool          hostileOnly{ true };
+    };
+
+    // Picks the candidates a parry staggers: living, optionally hostile, inside the cone around
+    // a_heading (game convention: 0 faces +y, the angle grows towards +x) and at most maxTargets of
+    // them, nearest first. Writes candidate indices into a_out and returns how many passed the
+    // filters before the cap, so the caller can tell how many were dropped.
+    inline std::size_t SelectParryTargets(std::span<const ParryCandidate> a_candidates, float a_heading, const ParryFilter& a_filter,
+                                          std::vector<std::uint32_t>& a_out)
+    {
+        a_out.clear();
+
+        const bool  cone    = a_filter.coneDegrees < 360.0f;
+        const float forward = std::cos(a_filter.coneDegrees * 0.5f * 3.14159265f / 180.0f);
+        const float fx      = std::sin(a_heading);
+        const float fy      = std::cos(a_heading);
+
+        for (std::size_t i = 0; i < a_candidates.size(); ++i) {
+            const auto& candidate = a_candidates[i];
+            if (candidate.dead || (a_filter.hostileOnly && !candidate.hostile)) {
+                continue;
+            }
+            if (cone) {
+                // compare against cos(half angle) without normalizing: dot >= cos * |d|, squared with the sign kept
+                const float dot    = candidate.x * fx + candidate.y * fy;
+                const float length = candidate.x * candidate.x + candidate.y * candidate.y;
+                if (length > 0.0f && dot * std::fabs(dot) < forward * std::fabs(forward) * length) {
+                    continue;
+                }
+            }
+            a_out.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        const auto passed = a_out.size();
+        if (passed > a_filter.maxTargets) {
+            const auto distance = [&](std::uint32_t a_index) {
+                const auto& c = a_candidates[a_index];
+                return c.x * c.x + c.y * c.y;
+            };
+            std::nth_element(a_out.begin(), a_out.begin() + a_filter.maxTargets, a_out.end(),
+                             [&](std::uint32_t a_lhs, std::uint32_t a_rhs) { return distance(a_lhs) < distance(a_rhs); });
+            a_out.resize(a_filter.maxTargets);
+        }
+        return passed;
+    }
+} // namespace Core
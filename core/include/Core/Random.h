@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <span>
+
+namespace Core
+{
+    // xoshiro128+ for floats and xoshiro128** for integers (Blackman/Vigna), 16 bytes of state.
+    // Much cheaper than std::mt19937 plus a distribution object per call, and each thread gets its
+    // own state through ThreadRng(), so callers on task or worker threads don't share anything.
+    class Rng
+    {
+    public:
+        explicit Rng(std::uint64_t a_seed = 0x9E3779B97F4A7C15ull) noexcept { Seed(a_seed); }
+
+        void Seed(std::uint64_t a_seed) noexcept
+        {
+            // splitmix64 spreads any seed (0 included) over the whole state
+            for (auto& word : state) {
+                a_seed += 0x9E3779B97F4A7C15ull;
+                auto z = a_seed;
+                z      = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z      = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                word   = static_cast<std::uint32_t>(z ^ (z >> 31));
+            }
+        }
+
+        std::uint32_t Next() noexcept
+        {
+            const auto result = std::rotl(state[1] * 5, 7) * 9;
+            Advance();
+            return result;
+        }
+
+        // [0, 1)
+        float NextFloat() noexcept
+        {
+            const auto result = state[0] + state[3];
+            Advance();
+            return static_cast<float>(result >> 8) * 0x1.0p-24f;
+        }
+
+        // [0, 1)
+        double NextDouble() noexcept
+        {
+            const std::uint64_t hi = Next() >> 5;
+            const std::uint64_t lo = Next() >> 6;
+            return static_cast<double>((hi << 26) | lo) * 0x1.0p-53;
+        }
+
+        // [a_min, a_max], Lemire's multiply-shift, the bias is far below anything gameplay can notice
+        std::int32_t UniformInt(std::int32_t a_min, std::int32_t a_max) noexcept
+        {
+            if (a_max <= a_min) {
+                return a_min;
+            }
+            const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(a_max) - a_min) + 1;
+            return static_cast<std::int32_t>(a_min + static_cast<std::int64_t>((Next() * range) >> 32));
+        }
+
+        double UniformDouble(double a_min, double a_max) noexcept { return a_min + NextDouble() * (a_max - a_min); }
+
+        float UniformFloat(float a_min, float a_max) noexcept { return a_min + NextFloat() * (a_max - a_min); }
+
+        void FillUniform(std::span<float> a_out, float a_min, float a_max) noexcept
+        {
+            const auto scale = a_max - a_min;
+            for (auto& value : a_out) {
+                value = a_min + NextFloat() * scale;
+            }
+        }
+
+        struct DiscPoint
+        {
+            float x;
+            float y;
+        };
+
+        // Uniform point in a disc of a_radius around the origin
+        DiscPoint NextInDisc(float a_radius) noexcept
+        {
+            const auto r     = a_radius * std::sqrt(NextFloat());
+            const auto theta = NextFloat() * 2.0f * std::numbers::pi_v<float>;
+            return { r * std::cos(theta), r * std::sin(theta) };
+        }
+
+        void FillDisc(std::span<DiscPoint> a_out, float a_radius) noexcept
+        {
+            for (auto& point : a_out) {
+                point = NextInDisc(a_radius);
+            }
+        }
+
+    private:
+        void Advance() noexcept
+        {
+            const auto t = state[1] << 9;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = std::rotl(state[3], 11);
+        }
+
+        std::uint32_t state[4];
+    };
+
+    namespace detail
+    {
+        inline std::atomic<std::uint64_t> rngSeed{ 0 };
+        inline std::atomic<std::uint32_t> rngGeneration{ 0 };
+        inline std::atomic<std::uint32_t> rngThreads{ 0 };
+    } // namespace detail
+
+    // Makes every thread's generator deterministic (seed mixed with the order threads first draw
+    // in), for replaying recorded sessions. 0 goes back to seeding from std::random_device.
+    inline void SetRandomSeed(std::uint64_t a_seed) noexcept
+    {
+        detail::rngSeed.store(a_seed, std::memory_order_relaxed);
+        detail::rngThreads.store(0, std::memory_order_relaxed);
+        detail::rngGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    // The calling thread's generator, reseeded lazily after SetRandomSeed
+    inline Rng& ThreadRng() noexcept
+    {
+        thread_local Rng           rng{ 0 };
+        thread_local std::uint32_t generation{ ~0u };
+
+        const auto current = detail::rngGeneration.load(std::memory_order_acquire);
+        if (generation != current) {
+            generation       = current;
+            const auto seed  = detail::rngSeed.load(std::memory_order_relaxed);
+            const auto index = detail::rngThreads.fetch_add(1, std::memory_order_relaxed);
+            if (seed) {
+                rng.Seed(seed + index * 0x9E3779B97F4A7C15ull);
+            }
+            else {
+                std::random_device device;
+                rng.Seed((static_cast<std::uint64_t>(device()) << 32) | device());
+            }
+        }
+        return rng;
+    }
+} // namespace Core
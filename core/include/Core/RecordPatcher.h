@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Core/WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Core
+{
+    // One record level rewrite applied at data load. a_apply returns true when it changed the record.
+    template <typename T>
+    struct PatchRule
+    {
+        const char*             name;
+        std::function<bool(T&)> apply;
+    };
+
+    struct PatchRuleStats
+    {
+        const char*   name;
+        std::uint64_t patched{ 0 };
+        double        ms{ 0.0 }; // summed over all workers
+    };
+
+    struct PatchReport
+    {
+        std::vector<PatchRuleStats> rules;
+        std::uint64_t               records{ 0 };
+        std::size_t                 workers{ 0 };
+        double                      wallMs{ 0.0 };
+    };
+
+    // Runs every rule over every record. The records are cut into chunks that the calling thread and
+    // up to one helper job per pool worker pull from a shared counter; inside a chunk the rules run
+    // one after the other so each rule is timed once per chunk rather than once per record. Rules
+    // must only touch the record they are given, records are never visited by two workers. Null
+    // records are skipped. Without a pool, or below a_parallelThreshold records where handing chunks
+    // out costs more than the loop, everything runs on the caller. Helpers that only get a worker
+    // after the caller ran out of chunks return without touching anything, so calling this from a
+    // job on the same pool cannot deadlock.
+    template <typename T>
+    PatchReport PatchRecords(std::span<T* const> a_records, std::span<const PatchRule<T>> a_rules, WorkerPool* a_pool = nullptr,
+                             std::size_t a_parallelThreshold = 16384, std::size_t a_chunkSize = 512)
+    {
+        using clock = std::chrono::steady_clock;
+
+        PatchReport report;
+        report.records = a_records.size();
+        for (const auto& rule : a_rules) {
+            report.rules.push_back({ rule.name });
+        }
+        if (a_records.empty() || a_rules.empty()) {
+            return report;
+        }
+
+        const auto start  = clock::now();
+        a_chunkSize       = std::max<std::size_t>(a_chunkSize, 1);
+        const auto chunks = (a_records.size() + a_chunkSize - 1) / a_chunkSize;
+
+        struct Shared
+        {
+            std::atomic<std::size_t>    nextChunk{ 0 };
+            std::mutex                  mutex;
+            std::condition_variable     done;
+            std::size_t                 running{ 0 };
+            std::size_t                 helped{ 0 };
+            bool                        closed{ false };
+            std::vector<PatchRuleStats> stats;
+        };
+        const auto shared = std::make_shared<Shared>();
+        shared->stats     = report.rules;
+
+        // only touches a_records and a_rules while counted in running, the caller waits for those
+        const auto work = [chunks, a_chunkSize, records = a_records, rules = a_rules](Shared& a_shared, std::vector<PatchRuleStats>& a_stats) {
+            for (auto chunk = a_shared.nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+                 chunk      = a_shared.nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+                const auto slice = records.subspan(chunk * a_chunkSize, std::min(a_chunkSize, records.size() - chunk * a_chunkSize));
+                for (std::size_t r = 0; r < rules.size(); ++r) {
+                    const auto    ruleStart = clock::now();
+                    std::uint64_t patched   = 0;
+                    for (auto record : slice) {
+                        if (record) {
+                            patched += rules[r].apply(*record);
+                        }
+                    }
+                    a_stats[r].patched += patched;
+                    a_stats[r].ms += std::chrono::duration<double, std::milli>(clock::now() - ruleStart).count();
+                }
+            }
+        };
+        const auto merge = [](std::vector<PatchRuleStats>& a_into, const std::vector<PatchRuleStats>& a_from) {
+            for (std::size_t r = 0; r < a_from.size(); ++r) {
+                a_into[r].patched += a_from[r].patched;
+                a_into[r].ms += a_from[r].ms;
+            }
+        };
+
+        const auto helpers = a_pool && a_records.size() >= a_parallelThreshold ? std::min(a_pool->Size(), chunks - 1) : 0;
+        for (std::size_t i = 0; i < helpers; ++i) {
+            a_pool->Submit([shared, work, merge, rules = a_rules.size()] {
+                {
+                    std::lock_guard lock(shared->mutex);
+                    if (shared->closed) {
+                        return;
+                    }
+                    shared->running++;
+                }
+                std::vector<PatchRuleStats> stats(rules);
+                work(*shared, stats);
+
+                std::lock_guard lock(shared->mutex);
+                merge(shared->stats, stats);
+                shared->helped++;
+                if (--shared->running == 0) {
+                    shared->done.notify_all();
+                }
+            });
+        }
+
+        auto own = report.rules;
+        work(*shared, own);
+        {
+            std::unique_lock lock(shared->mutex);
+            shared->closed = true;
+            shared->done.wait(lock, [&] { return shared->running == 0; });
+            merge(own, shared->stats);
+            report.workers = 1 + shared->helped;
+        }
+
+        report.rules  = std::move(own);
+        report.wallMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        return report;
+    }
+} // namespace Core
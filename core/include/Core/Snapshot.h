@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Core
+{
+    // Immutable value published behind an atomic pointer. Readers take a reference with Get(), one
+    // acquire load and no lock, and keep reading a consistent snapshot even while a writer
+    // publishes a new one. Superseded snapshots are retired but never freed before the owner dies,
+    // which is what makes holding a reference across a reload safe; reloads are rare and the values
+    // are small, so the retired list stays tiny. Publish() may be called from any thread.
+    template <typename T>
+    class Snapshot
+    {
+    public:
+        Snapshot() : Snapshot(std::make_unique<const T>()) {}
+        explicit Snapshot(std::unique_ptr<const T> a_initial) { Publish(std::move(a_initial)); }
+
+        Snapshot(const Snapshot&)            = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        const T& Get() const noexcept { return *current.load(std::memory_order_acquire); }
+
+        // Returns the snapshot that was replaced
+        const T& Publish(std::unique_ptr<const T> a_next)
+        {
+            std::lock_guard lock(writer);
+            const T*        previous = current.load(std::memory_order_relaxed);
+            current.store(a_next.get(), std::memory_order_release);
+            owned.push_back(std::move(a_next));
+            return previous ? *previous : *owned.back();
+        }
+
+        std::size_t Generations() const
+        {
+            std::lock_guard lock(writer);
+            return owned.size();
+        }
+
+    private:
+        std::atomic<const T*>                 current{ nullptr };
+        mutable std::mutex                    writer;
+        std::vector<std::unique_ptr<const T>> owned;
+    };
+} // namespace Core
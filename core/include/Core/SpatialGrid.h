@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+    // Uniform grid over the xy plane, stored as a spatial hash so the world bounds don't matter.
+    // Fill it with Add(), call Build() once, then run any number of radius queries against it.
+    // Distances are full 3D like NiPoint3::GetSquaredDistance, z is only ignored for cell selection.
+    template <typename T>
+    class SpatialGrid
+    {
+    public:
+        struct Entry
+        {
+            float        x;
+            float        y;
+            float        z;
+            std::int32_t cellX;
+            std::int32_t cellY;
+            T            value;
+        };
+
+        explicit SpatialGrid(float a_cellSize = 512.0f) : cellSize(a_cellSize), invCellSize(1.0f / a_cellSize) {}
+
+        void Clear()
+        {
+            pending.clear();
+            entries.clear();
+            built = false;
+        }
+
+        void Add(float a_x, float a_y, float a_z, const T& a_value)
+        {
+            pending.push_back({ a_x, a_y, a_z, CellOf(a_x), CellOf(a_y), a_value });
+            built = false;
+        }
+
+        // Counting sort of the pending entries into their buckets. O(n), reuses all storage between frames.
+        void Build()
+        {
+            const auto bucketCount = std::bit_ceil(std::max<std::size_t>(pending.size() * 2, 16));
+            bucketMask             = static_cast<std::uint32_t>(bucketCount - 1);
+            bucketStart.assign(bucketCount + 1, 0);
+
+            for (const auto& entry : pending) {
+                ++bucketStart[Bucket(entry.cellX, entry.cellY) + 1];
+            }
+            for (std::size_t i = 1; i < bucketStart.size(); ++i) {
+                bucketStart[i] += bucketStart[i - 1];
+            }
+
+            entries.resize(pending.size());
+            cursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+            for (const auto& entry : pending) {
+                entries[cursor[Bucket(entry.cellX, entry.cellY)]++] = entry;
+            }
+            pending.clear();
+            built = true;
+        }
+
+        [[nodiscard]] bool        IsBuilt() const noexcept { return built; }
+        [[nodiscard]] std::size_t Size() const noexcept { return entries.size(); }
+        [[nodiscard]] float       CellSize() const noexcept { return cellSize; }
+
+        // Calls a_func(const Entry&) for every entry within a_radius of the point
+        template <typename F>
+        void ForEachWithin(float a_x, float a_y, float a_z, float a_radius, F&& a_func) const
+        {
+            if (entries.empty()) {
+                return;
+            }
+
+            const auto squaredRadius = a_radius * a_radius;
+            const auto minX          = CellOf(a_x - a_radius);
+            const auto maxX          = CellOf(a_x + a_radius);
+            const auto minY          = CellOf(a_y - a_radius);
+            const auto maxY          = CellOf(a_y + a_radius);
+
+            // huge radius relative to the population, visiting cells would cost more than a plain scan
+            const auto cellCount = static_cast<std::uint64_t>(maxX - minX + 1) * static_cast<std::uint64_t>(maxY - minY + 1);
+            if (cellCount > entries.size()) {
+                for (const auto& entry : entries) {
+                    if (SquaredDistance(entry, a_x, a_y, a_z) <= squaredRadius) {
+                        a_func(entry);
+                    }
+                }
+                return;
+            }
+
+            for (auto cy = minY; cy <= maxY; ++cy) {
+                for (auto cx = minX; cx <= maxX; ++cx) {
+                    const auto bucket = Bucket(cx, cy);
+                    for (auto i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                        const auto& entry = entries[i];
+                        // different cells can share a bucket, only count each entry from its own cell
+                        if (entry.cellX != cx || entry.cellY != cy) {
+                            continue;
+                        }
+                        if (SquaredDistance(entry, a_x, a_y, a_z) <= squaredRadius) {
+                            a_func(entry);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Number of entries within a_radius for which a_filter(const Entry&) returns true
+        template <typename F>
+        std::int32_t CountWithin(float a_x, float a_y, float a_z, float a_radius, F&& a_filter) const
+        {
+            std::int32_t result = 0;
+            ForEachWithin(a_x, a_y, a_z, a_radius, [&](const Entry& a_entry) {
+                if (a_filter(a_entry)) {
+                    ++result;
+                }
+            });
+            return result;
+        }
+
+    private:
+        [[nodiscard]] static float SquaredDistance(const Entry& a_entry, float a_x, float a_y, float a_z) noexcept
+        {
+            const auto dx = a_entry.x - a_x;
+            const auto dy = a_entry.y - a_y;
+            const auto dz = a_entry.z - a_z;
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        [[nodiscard]] std::int32_t CellOf(float a_coord) const noexcept { return static_cast<std::int32_t>(std::floor(a_coord * invCellSize)); }
+
+        [[nodiscard]] std::uint32_t Bucket(std::int32_t a_cellX, std::int32_t a_cellY) const noexcept
+        {
+            const auto hash = static_cast<std::uint32_t>(a_cellX) * 73856093u ^ static_cast<std::uint32_t>(a_cellY) * 19349663u;
+            return hash & bucketMask;
+        }
+
+        float                      cellSize;
+        float                      invCellSize;
+        std::uint32_t              bucketMask{ 0 };
+        bool                       built{ false };
+        std::vector<Entry>         pending;
+        std::vector<Entry>         entries;
+        std::vector<std::uint32_t> bucketStart;
+        std::vector<std::uint32_t> cursor;
+    };
+} // namespace Core
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Core
+{
+    // Decides which tracked states need to be re-evaluated on a frame.
+    // Event sinks (any thread) call MarkDirty with the states an event may have changed; the frame
+    // update (one thread) calls Consume, which keeps a marked state due for a few frames so flags
+    // that the engine only settles after the event still get picked up, and optionally marks
+    // everything due every reconcileInterval frames as a safety net for missed events.
+    template <std::size_t N>
+    class StateTracker
+    {
+        static_assert(N <= 32, "StateTracker uses a 32 bit mask");
+
+    public:
+        using Mask = std::uint32_t;
+
+        static constexpr Mask         allStates    = N == 32 ? ~Mask{ 0 } : (Mask{ 1 } << N) - 1;
+        static constexpr std::uint8_t settleFrames = 3;
+
+        static constexpr Mask Bit(std::size_t a_state) noexcept { return Mask{ 1 } << a_state; }
+
+        void MarkDirty(Mask a_states) noexcept { incoming.fetch_or(a_states, std::memory_order_relaxed); }
+        void MarkAllDirty() noexcept { MarkDirty(allStates); }
+
+        // Returns the states to evaluate this frame, a_reconcileInterval == 0 disables the reconciliation poll
+        Mask Consume(std::uint32_t a_reconcileInterval) noexcept
+        {
+            auto marked = incoming.exchange(0, std::memory_order_relaxed);
+
+            if (a_reconcileInterval && ++framesSinceReconcile >= a_reconcileInterval) {
+                framesSinceReconcile = 0;
+                marked |= allStates;
+            }
+
+            Mask due = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (marked & Bit(i)) {
+                    settle[i] = settleFrames;
+                }
+                if (settle[i]) {
+                    --settle[i];
+                    due |= Bit(i);
+                }
+            }
+            return due;
+        }
+
+    private:
+        std::atomic<Mask>           incoming{ allStates };
+        std::array<std::uint8_t, N> settle{};
+        std::uint32_t               framesSinceReconcile{ 0 };
+    };
+} // namespace Core
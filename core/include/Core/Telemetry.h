@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Core/CombatRules.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Combat telemetry: the plugin writes the inputs and the result of every formula call it makes
+// into a flat file of fixed size records, the replayer (tools/replay.cpp) feeds the same inputs
+// through the formulas in this library to check them, A/B a changed formula and benchmark it.
+namespace Core
+{
+    enum class TelemetryKind : std::uint8_t
+    {
+        kBlockStamina,       // in: percentBlocked, physicalDamage, stagger, staggerMult, damageMult, base    flag0: block perk
+        kBashStamina,        // in: staminaMult, bashBase, powerBashBase                                      flag0: power, flag1: bash perk
+        kPowerAttackStamina, // in: weaponWeight, weaponBase, weaponMult, penalty, staminaMult, final cost    out: cost before entry points
+        kPitFighterMelee,    // in: damage, enemies, minEnemy, midEnemy, maxEnemy
+        kPitFighterBow,      // in: damage, enemies, minEnemy, midEnemy, maxEnemy
+        kPitFighterSpell,    // in: magnitude, enemies, minEnemy, midEnemy, maxEnemy
+        kHitFrameStamina,    // in: weaponClass, stamina global                                               flag0: dual wielding, flag1: player
+        kHit,                // in: defender is player                                                        flags: bash, power, blocked
+        kParry,              // in: staggered actors                                                          flag0: shield
+
+        kTotal
+    };
+
+    struct TelemetryRecord
+    {
+        std::uint32_t timeMs;
+        TelemetryKind kind;
+        std::uint8_t  flags;
+        std::uint16_t reserved;
+        float         in[7];
+        float         out;
+    };
+    static_assert(sizeof(TelemetryRecord) == 40);
+
+    struct TelemetryHeader
+    {
+        static constexpr std::uint32_t magicValue   = 0x4C544750; // "PGTL"
+        static constexpr std::uint32_t versionValue = 1;
+
+        std::uint32_t              magic;
+        std::uint32_t              version;
+        std::uint32_t              recordSize;
+        std::uint32_t              capacity;
+        std::atomic<std::uint64_t> written; // claimed slots, may exceed capacity once the file is full
+        std::uint64_t              reserved[5];
+    };
+    static_assert(sizeof(TelemetryHeader) == 64);
+
+    constexpr std::size_t TelemetryFileSize(std::uint32_t a_capacity) noexcept
+    {
+        return sizeof(TelemetryHeader) + static_cast<std::size_t>(a_capacity) * sizeof(TelemetryRecord);
+    }
+
+    // Writes records into a block of memory laid out as the telemetry file (a mapped view in the
+    // plugin). Any thread may Write(): a slot is claimed with one atomic add and filled in place,
+    // once the file is full further records are counted and dropped.
+    class TelemetryWriter
+    {
+    public:
+        // a_memory must hold TelemetryFileSize(a_capacity) bytes, the header is (re)initialized
+        bool Attach(void* a_memory, std::uint32_t a_capacity) noexcept;
+        void Detach() noexcept { header = nullptr; }
+
+        bool Active() const noexcept { return header != nullptr; }
+
+        bool Write(const TelemetryRecord& a_record) noexcept
+        {
+            if (!header) {
+                return false;
+            }
+            const auto slot = header->written.fetch_add(1, std::memory_order_relaxed);
+            if (slot >= header->capacity) {
+                return false;
+            }
+            records[slot] = a_record;
+            return true;
+        }
+
+    private:
+        TelemetryHeader* header{ nullptr };
+        TelemetryRecord* records{ nullptr };
+    };
+
+    // Validates a recorded file image and returns its records, empty on a bad or foreign file
+    std::span<const TelemetryRecord> ReadTelemetry(std::span<const std::byte> a_file) noexcept;
+
+    // Formula parameters the replayer can swap for an A/B run, unset ones come from the record
+    struct TelemetryOverrides
+    {
+        const BlockStaminaSettings*       block{ nullptr };
+        const BashStaminaSettings*        bash{ nullptr };
+        const PowerAttackStaminaSettings* powerAttack{ nullptr };
+        const PitFighterModifiers*        pitFighter{ nullptr };
+        double                            hitFrameGlobalMult{ 1.0 };
+    };
+
+    // Runs a record's inputs through the formula it was recorded from. Returns false for event
+    // records (kHit, kParry) that have no formula behind them.
+    bool ReplayTelemetry(const TelemetryRecord& a_record, const TelemetryOverrides& a_overrides, float& a_out) noexcept;
+} // namespace Core
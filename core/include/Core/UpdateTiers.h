@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Core
+{
+    enum class UpdateTier : std::uint8_t
+    {
+        kNear, // in combat or within the near radius: every frame
+        kMid,  // within the far radius: every midInterval frames
+        kFar,  // beyond: only when something marked the actor changed
+
+        kTotal
+    };
+
+    struct UpdateTierSettings
+    {
+        float         nearRadius{ 1500.0f };
+        float         farRadius{ 4096.0f };
+        std::uint32_t midInterval{ 4 };
+    };
+
+    struct UpdateTierCounts
+    {
+        std::array<std::uint32_t, static_cast<std::size_t>(UpdateTier::kTotal)> seen{};
+        std::array<std::uint32_t, static_cast<std::size_t>(UpdateTier::kTotal)> serviced{};
+    };
+
+    // Level of detail schedule for per-actor work done from a per-actor update callback.
+    // The frame hook calls BeginFrame() once per frame, the callback classifies its actor and asks
+    // ShouldService(). A mid tier actor's phase is a hash of its key, so a crowd costs about
+    // 1/midInterval of its size on every frame instead of all of it on the same frame, without any
+    // per-actor state or lock. Counters are per frame, LastFrame() returns the previous one.
+    class UpdateTierScheduler
+    {
+    public:
+        static UpdateTier Classify(const UpdateTierSettings& a_settings, float a_distanceSquared, bool a_inCombat) noexcept
+        {
+            if (a_inCombat || a_distanceSquared <= a_settings.nearRadius * a_settings.nearRadius) {
+                return UpdateTier::kNear;
+            }
+            if (a_distanceSquared <= a_settings.farRadius * a_settings.farRadius) {
+                return UpdateTier::kMid;
+            }
+            return UpdateTier::kFar;
+        }
+
+        // a_changed: the actor was marked by a state change event since it was last serviced
+        bool ShouldService(const UpdateTierSettings& a_settings, UpdateTier a_tier, std::uint32_t a_key, bool a_changed) noexcept
+        {
+            bool due = a_changed;
+            switch (a_tier) {
+            case UpdateTier::kNear:
+                due = true;
+                break;
+            case UpdateTier::kMid:
+                due = due || a_settings.midInterval <= 1 || IsPhaseDue(a_key, a_settings.midInterval);
+                break;
+            default:
+                break;
+            }
+
+            const auto tier = static_cast<std::size_t>(a_tier);
+            seen[tier].fetch_add(1, std::memory_order_relaxed);
+            if (due) {
+                serviced[tier].fetch_add(1, std::memory_order_relaxed);
+            }
+            return due;
+        }
+
+        void BeginFrame() noexcept
+        {
+            for (std::size_t i = 0; i < seen.size(); ++i) {
+                last.seen[i]     = seen[i].exchange(0, std::memory_order_relaxed);
+                last.serviced[i] = serviced[i].exchange(0, std::memory_order_relaxed);
+            }
+            frame.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const UpdateTierCounts& LastFrame() const noexcept { return last; }
+
+    private:
+        // murmur3 finalizer, so ids that share a stride with the interval still spread over the phases
+        static constexpr std::uint32_t Mix(std::uint32_t a_key) noexcept
+        {
+            a_key ^= a_key >> 16;
+            a_key *= 0x85EBCA6Bu;
+            a_key ^= a_key >> 13;
+            a_key *= 0xC2B2AE35u;
+            a_key ^= a_key >> 16;
+            return a_key;
+        }
+
+        bool IsPhaseDue(std::uint32_t a_key, std::uint32_t a_interval) const noexcept
+        {
+            return (frame.load(std::memory_order_relaxed) + Mix(a_key) % a_interval) % a_interval == 0;
+        }
+
+        std::atomic<std::uint32_t>                                                           frame{ 0 };
+        std::array<std::atomic<std::uint32_t>, static_cast<std::size_t>(UpdateTier::kTotal)> seen{};
+        std::array<std::atomic<std::uint32_t>, static_cast<std::size_t>(UpdateTier::kTotal)> serviced{};
+        UpdateTierCounts                                                                     last;
+    };
+} // namespace Core
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+    // Small work stealing thread pool for pure computation. Every worker owns a deque: jobs
+    // submitted from outside the pool are dealt round robin, jobs submitted from a worker go to the
+    // back of its own deque. A worker takes from the back of its own deque first (the freshest, still
+    // cached work) and steals from the front of the others when it runs dry, then sleeps until the
+    // next Submit(). Jobs must not touch engine state, hand results back through a CommitQueue.
+    class WorkerPool
+    {
+    public:
+        using Job = std::function<void()>;
+
+        explicit WorkerPool(std::size_t a_workers)
+        {
+            a_workers = a_workers ? a_workers : 1;
+            for (std::size_t i = 0; i < a_workers; ++i) {
+                queues.push_back(std::make_unique<Queue>());
+            }
+            for (std::size_t i = 0; i < a_workers; ++i) {
+                threads.emplace_back([this, i](std::stop_token a_stop) { Work(i, a_stop); });
+            }
+        }
+
+        // threads is the last member, the jthreads are stopped (waking the sleepers through their
+        // stop tokens) and joined before anything they use goes away. Queued jobs are dropped.
+        ~WorkerPool() = default;
+
+        WorkerPool(const WorkerPool&)            = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        std::size_t Size() const noexcept { return queues.size(); }
+
+        void Submit(Job a_job)
+        {
+            inFlight.fetch_add(1, std::memory_order_relaxed);
+            const auto index = currentPool == this ? currentWorker : next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                auto&           queue = *queues[index];
+                std::lock_guard lock(queue.mutex);
+                queue.jobs.push_back(std::move(a_job));
+            }
+            {
+                std::lock_guard lock(sleepMutex);
+                pending++;
+            }
+            wake.notify_one();
+        }
+
+        // Jobs queued or running, for benchmarks waiting on a batch
+        std::size_t Pending() const noexcept { return inFlight.load(std::memory_order_acquire); }
+
+        void WaitIdle() const noexcept
+        {
+            while (Pending()) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        struct Queue
+        {
+            std::mutex      mutex;
+            std::deque<Job> jobs;
+        };
+
+        bool TryTake(std::size_t a_index, Job& a_out)
+        {
+            {
+                auto&           own = *queues[a_index];
+                std::lock_guard lock(own.mutex);
+                if (!own.jobs.empty()) {
+                    a_out = std::move(own.jobs.back());
+                    own.jobs.pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t i = 1; i < queues.size(); ++i) {
+                auto&           victim = *queues[(a_index + i) % queues.size()];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.jobs.empty()) {
+                    a_out = std::move(victim.jobs.front());
+                    victim.jobs.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Work(std::size_t a_index, std::stop_token a_stop)
+        {
+            currentPool   = this;
+            currentWorker = a_index;
+
+            Job job;
+            while (!a_stop.stop_requested()) {
+                {
+                    std::unique_lock lock(sleepMutex);
+                    if (!wake.wait(lock, a_stop, [this] { return pending > 0; })) {
+                        return;
+                    }
+                    pending--;
+                }
+                // a job is queued before it is counted, so every counted wake up finds one, only
+                // not necessarily the one it was woken for
+                if (TryTake(a_index, job)) {
+                    job();
+                    job = nullptr;
+                    inFlight.fetch_sub(1, std::memory_order_release);
+                }
+            }
+        }
+
+        static inline thread_local const WorkerPool* currentPool{ nullptr };
+        static inline thread_local std::size_t       currentWorker{ 0 };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::atomic<std::size_t>            next{ 0 };
+        std::mutex                          sleepMutex;
+        std::condition_variable_any         wake;
+        std::size_t                         pending{ 0 };
+        std::atomic<std::size_t>            inFlight{ 0 };
+        std::vector<std::jthread>           threads;
+    };
+} // namespace Core
@@ -0,0 +1,103 @@
+#include "Core/ArmorCurve.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+namespace Core
+{
+    ArmorCurve ArmorCurve::Compile(std::span<const ArmorCurvePoint> a_points)
+    {
+        std::vector<ArmorCurvePoint> points;
+        for (const auto& point : a_points) {
+            if (point.rating > 0.0f && point.resist >= 0.0f && point.resist <= 1.0f) {
+                points.push_back(point);
+            }
+        }
+        std::ranges::sort(points, {}, &ArmorCurvePoint::rating);
+
+        ArmorCurve curve{ PassThrough{} };
+        if (points.empty()) {
+            return curve;
+        }
+
+        const float first = points.front().rating;
+        const float span  = std::max(points.back().rating - first, 1.0f);
+        const float step  = span / static_cast<float>(nodes - 1);
+        curve.first       = first;
+        curve.invStep     = 1.0f / step;
+
+        std::size_t segment = 0;
+        for (std::size_t i = 0; i < nodes; ++i) {
+            const float rating = first + step * static_cast<float>(i);
+            while (segment + 1 < points.size() && points[segment + 1].rating <= rating) {
+                segment++;
+            }
+            if (segment + 1 == points.size()) {
+                curve.table[i] = points.back().resist;
+                continue;
+            }
+            const auto& from = points[segment];
+            const auto& to   = points[segment + 1];
+            const float t    = (rating - from.rating) / (to.rating - from.rating);
+            curve.table[i]   = from.resist + (to.resist - from.resist) * t;
+        }
+        return curve;
+    }
+
+    bool ArmorCurve::Parse(std::string_view a_text, std::vector<ArmorCurvePoint>& a_out)
+    {
+        const auto trim = [](std::string_view a_view) {
+            while (!a_view.empty() && std::isspace(static_cast<unsigned char>(a_view.front()))) {
+                a_view.remove_prefix(1);
+            }
+            while (!a_view.empty() && std::isspace(static_cast<unsigned char>(a_view.back()))) {
+                a_view.remove_suffix(1);
+            }
+            return a_view;
+        };
+        const auto number = [](std::string_view a_view, float& a_value) {
+            const auto [end, error] = std::from_chars(a_view.data(), a_view.data() + a_view.size(), a_value);
+            return error == std::errc{} && end == a_view.data() + a_view.size();
+        };
+
+        std::vector<ArmorCurvePoint> points;
+        while (!a_text.empty()) {
+            const auto comma = a_text.find(',');
+            const auto item  = trim(a_text.substr(0, comma));
+            a_text           = comma == std::string_view::npos ? std::string_view{} : a_text.substr(comma + 1);
+
+            const auto colon = item.find(':');
+            if (colon == std::string_view::npos) {
+                return false;
+            }
+            ArmorCurvePoint point{};
+            if (!number(trim(item.substr(0, colon)), point.rating) || !number(trim(item.substr(colon + 1)), point.resist)) {
+                return false;
+            }
+            points.push_back(point);
+        }
+        if (points.empty()) {
+            return false;
+        }
+        a_out = std::move(points);
+        return true;
+    }
+
+    void ArmorCurve::Evaluate(std::span<const float> a_vanilla, float a_scalingFactor, std::span<float> a_out) const noexcept
+    {
+        const float scale  = invStep * 100.0f / a_scalingFactor;
+        const float offset = first * invStep;
+        const auto  count  = std::min(a_vanilla.size(), a_out.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            const float vanilla  = a_vanilla[i];
+            const float position = vanilla * scale - offset;
+            const float clamped  = std::clamp(position, 0.0f, lastNode);
+            const auto  index    = static_cast<std::size_t>(std::min(clamped, lastNode - 1.0f));
+            const float t        = clamped - static_cast<float>(index);
+            const float curved   = table[index] + (table[index + 1] - table[index]) * t;
+            a_out[i]             = position > 0.0f ? curved : vanilla;
+        }
+    }
+} // namespace Core
@@ -0,0 +1,90 @@
+#include "Core/CombatRules.h"
+
+#include <iterator>
+
+namespace Core
+{
+    float GetBlockStaminaDamage(const BlockStaminaSettings& a_settings, const BlockedHit& a_hit)
+    {
+        float perkMult  = a_hit.hasBlockPerk ? 0.5f : 1.0f;
+        auto  actualDmg = a_hit.percentBlocked * a_hit.physicalDamage;
+
+        auto stagger        = a_hit.stagger * a_settings.staggerMult;
+        auto damagScaleStam = actualDmg * a_settings.damageMult;
+
+        return (stagger + a_settings.base + damagScaleStam) * perkMult;
+    }
+
+    float GetBashStamina(const BashStaminaSettings& a_settings, const BashAttack& a_attack)
+    {
+        auto  bashAttackStamina  = a_attack.powerAttack ? a_settings.powerBashBase : a_settings.bashBase;
+        float playerBashPerkMult = a_attack.hasBashPerk ? 0.5f : 1.0f;
+
+        return (bashAttackStamina * a_attack.staminaMult) * playerBashPerkMult;
+    }
+
+    float GetPowerAttackBaseStamina(const PowerAttackStaminaSettings& a_settings, float a_weaponWeight)
+    {
+        return (a_settings.weaponBase + (a_weaponWeight * a_settings.weaponMult)) * a_settings.powerAttackPenalty;
+    }
+
+    float AdjustArmorRating(float a_vanilla, float a_scalingFactor)
+    {
+        auto armorRating = (a_vanilla / a_scalingFactor) * 100;
+
+        if (armorRating <= 500) {
+            return a_vanilla;
+        }
+        else if (armorRating < 1000) {
+            auto remainderRating = armorRating - 500;
+            return 0.75f + (remainderRating / 100 * 0.03f);
+        }
+        else {
+            return 0.90f;
+        }
+    }
+
+    float GetPitFighterMeleeMult(const PitFighterModifiers& a_mods, std::int32_t a_enemies)
+    {
+        if (a_enemies <= 0) {
+            return 1.0f;
+        }
+        if (a_enemies <= 2) {
+            return a_mods.minEnemy;
+        }
+        if (a_enemies == 3) {
+            return a_mods.midEnemy;
+        }
+        return a_mods.maxEnemy;
+    }
+
+    float GetPitFighterRangedMult(const PitFighterModifiers& a_mods, std::int32_t a_enemies)
+    {
+        if (a_enemies >= 4) {
+            return a_mods.minEnemy;
+        }
+        if (a_enemies == 3) {
+            return a_mods.midEnemy;
+        }
+        return a_mods.maxEnemy;
+    }
+
+    double GetHitFrameStaminaCost(WeaponClass a_class, bool a_dualWielding, bool a_player, double a_global)
+    {
+        // multiplier on the stamina global per weapon class, { single, dual wielding }
+        constexpr double dual_wield_mod = 1.2;
+        constexpr double classMult[][2]{
+            { 0.0, 0.0 },                   // kOther, flat cost below
+            { 1.0, dual_wield_mod },        // kOneHanded
+            { 1.5, 1.5 },                   // kTwoHanded
+            { 0.8, 0.8 * dual_wield_mod },  // kDagger
+            { 0.8, 0.8 },                   // kHandToHand
+        };
+
+        const auto index = static_cast<std::size_t>(a_class);
+        if (index == 0 || index >= std::size(classMult)) {
+            return 10.0;
+        }
+        return a_global * classMult[index][a_player && a_dualWielding ? 1 : 0];
+    }
+} // namespace Core
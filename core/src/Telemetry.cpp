@@ -0,0 +1,83 @@
+#include "Core/Telemetry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace Core
+{
+    bool TelemetryWriter::Attach(void* a_memory, std::uint32_t a_capacity) noexcept
+    {
+        if (!a_memory || !a_capacity) {
+            return false;
+        }
+
+        auto file = static_cast<std::byte*>(a_memory);
+        std::memset(file, 0, sizeof(TelemetryHeader));
+        header             = new (file) TelemetryHeader{};
+        header->magic      = TelemetryHeader::magicValue;
+        header->version    = TelemetryHeader::versionValue;
+        header->recordSize = sizeof(TelemetryRecord);
+        header->capacity   = a_capacity;
+        records            = reinterpret_cast<TelemetryRecord*>(file + sizeof(TelemetryHeader));
+        return true;
+    }
+
+    std::span<const TelemetryRecord> ReadTelemetry(std::span<const std::byte> a_file) noexcept
+    {
+        if (a_file.size() < sizeof(TelemetryHeader)) {
+            return {};
+        }
+
+        const auto header = reinterpret_cast<const TelemetryHeader*>(a_file.data());
+        if (header->magic != TelemetryHeader::magicValue || header->version != TelemetryHeader::versionValue || header->recordSize != sizeof(TelemetryRecord)) {
+            return {};
+        }
+
+        std::uint64_t count = header->written.load(std::memory_order_relaxed);
+        count               = std::min<std::uint64_t>(count, header->capacity);
+        count               = std::min<std::uint64_t>(count, (a_file.size() - sizeof(TelemetryHeader)) / sizeof(TelemetryRecord));
+        return { reinterpret_cast<const TelemetryRecord*>(a_file.data() + sizeof(TelemetryHeader)), static_cast<std::size_t>(count) };
+    }
+
+    bool ReplayTelemetry(const TelemetryRecord& a_record, const TelemetryOverrides& a_overrides, float& a_out) noexcept
+    {
+        const auto& in      = a_record.in;
+        const auto  flag    = [&](int a_bit) { return (a_record.flags & (1u << a_bit)) != 0; };
+        const auto  enemies = static_cast<std::int32_t>(in[1]);
+
+        switch (a_record.kind) {
+        case TelemetryKind::kBlockStamina: {
+            const BlockStaminaSettings recorded{ in[3], in[4], in[5] };
+            a_out = GetBlockStaminaDamage(a_overrides.block ? *a_overrides.block : recorded, { in[0], in[1], in[2], flag(0) });
+            return true;
+        }
+        case TelemetryKind::kBashStamina: {
+            const BashStaminaSettings recorded{ in[1], in[2] };
+            a_out = GetBashStamina(a_overrides.bash ? *a_overrides.bash : recorded, { in[0], flag(0), flag(1) });
+            return true;
+        }
+        case TelemetryKind::kPowerAttackStamina: {
+            const PowerAttackStaminaSettings recorded{ in[1], in[2], in[3] };
+            a_out = GetPowerAttackBaseStamina(a_overrides.powerAttack ? *a_overrides.powerAttack : recorded, in[0]);
+            return true;
+        }
+        case TelemetryKind::kPitFighterMelee: {
+            const PitFighterModifiers recorded{ in[2], in[3], in[4] };
+            a_out = in[0] * GetPitFighterMeleeMult(a_overrides.pitFighter ? *a_overrides.pitFighter : recorded, enemies);
+            return true;
+        }
+        case TelemetryKind::kPitFighterBow:
+        case TelemetryKind::kPitFighterSpell: {
+            const PitFighterModifiers recorded{ in[2], in[3], in[4] };
+            a_out = in[0] * GetPitFighterRangedMult(a_overrides.pitFighter ? *a_overrides.pitFighter : recorded, enemies);
+            return true;
+        }
+        case TelemetryKind::kHitFrameStamina:
+            a_out = static_cast<float>(GetHitFrameStaminaCost(static_cast<WeaponClass>(in[0]), flag(0), flag(1), in[1] * a_overrides.hitFrameGlobalMult));
+            return true;
+        default:
+            return false;
+        }
+    }
+} // namespace Core
@@ -0,0 +1,195 @@
+#pragma once
+#include "Cache.h"
+
+// Per-actor membership index for the few magic effects the plugin keeps asking about
+// (stamina penalty, parry window, cooldowns), so the conditions don't walk the whole active
+// effect list of a heavily buffed actor every frame.
+// An actor is seeded with one list walk on its first query and is then kept current from the
+// engine's active effect apply/remove notifications. Unloading the actor or loading a save
+// drops its entry, the next query seeds it again. Untracked effects fall back to the list walk.
+class ActiveEffectIndex :
+    public RE::BSTEventSink<RE::TESActiveEffectApplyRemoveEvent>,
+    public RE::BSTEventSink<RE::TESObjectLoadedEvent>
+{
+public:
+    static constexpr std::size_t maxTracked = 8;
+
+    static ActiveEffectIndex* GetSingleton()
+    {
+        static ActiveEffectIndex singleton;
+        return &singleton;
+    }
+
+    void Register()
+    {
+        if (const auto holder = RE::ScriptEventSourceHolder::GetSingleton()) {
+            holder->AddEventSink<RE::TESActiveEffectApplyRemoveEvent>(this);
+            holder->AddEventSink<RE::TESObjectLoadedEvent>(this);
+            logger::info("Registered {}"sv, typeid(RE::TESActiveEffectApplyRemoveEvent).name());
+            logger::info("Registered {}"sv, typeid(RE::TESObjectLoadedEvent).name());
+        }
+    }
+
+    // Effects not found in the data files are skipped, the list is cut at maxTracked
+    void Track(std::initializer_list<RE::EffectSetting*> a_effects)
+    {
+        std::lock_guard lock(mutex);
+        tracked.fill(nullptr);
+        trackedCount = 0;
+        for (auto effect : a_effects) {
+            if (effect && trackedCount < maxTracked) {
+                tracked[trackedCount++] = effect;
+            }
+        }
+        actors.clear();
+        logger::info("indexing {} active effects", trackedCount);
+    }
+
+    void Clear()
+    {
+        std::lock_guard lock(mutex);
+        actors.clear();
+    }
+
+    bool Has(RE::Actor* a_actor, RE::EffectSetting* a_effect)
+    {
+        if (!a_actor || !a_effect) {
+            return false;
+        }
+        const auto slot = GetSlot(a_effect);
+        if (slot == maxTracked) {
+            return Scan(a_actor, a_effect);
+        }
+
+        std::lock_guard lock(mutex);
+        auto            it = actors.find(a_actor->GetFormID());
+        if (it == actors.end()) {
+            it = actors.emplace(a_actor->GetFormID(), Seed(a_actor)).first;
+        }
+        return it->second.counts[slot] > 0;
+    }
+
+    // Plain walk over the active effect list
+    static bool Scan(RE::Actor* a_actor, RE::EffectSetting* a_effect)
+    {
+        auto activeEffects = a_actor->AsMagicTarget()->GetActiveEffectList();
+        if (!activeEffects) {
+            return false;
+        }
+        for (auto& effect : *activeEffects) {
+            if (effect && effect->GetBaseObject() == a_effect) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESActiveEffectApplyRemoveEvent* a_event,
+                                          RE::BSTEventSource<RE::TESActiveEffectApplyRemoveEvent>*) override
+    {
+        if (!a_event || !a_event->target) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        std::lock_guard lock(mutex);
+        const auto      it = actors.find(a_event->target->GetFormID());
+        if (it == actors.end()) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        auto& entry = it->second;
+        auto  live  = std::ranges::find(entry.live, a_event->activeEffectUniqueID, &LiveEffect::uniqueID);
+
+        if (a_event->isApplied) {
+            if (live != entry.live.end()) {
+                return RE::BSEventNotifyControl::kContinue;
+            }
+            auto actor = a_event->target->As<RE::Actor>();
+            auto found = actor ? FindUnique(actor, a_event->activeEffectUniqueID) : std::nullopt;
+            if (!found) {
+                // the notification raced the list, let the next query seed the actor again
+                actors.erase(it);
+                return RE::BSEventNotifyControl::kContinue;
+            }
+            if (const auto slot = GetSlot(*found); slot != maxTracked) {
+                entry.live.push_back({ a_event->activeEffectUniqueID, static_cast<std::uint8_t>(slot) });
+                ++entry.counts[slot];
+            }
+        }
+        else if (live != entry.live.end()) {
+            --entry.counts[live->slot];
+            entry.live.erase(live);
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESObjectLoadedEvent* a_event, RE::BSTEventSource<RE::TESObjectLoadedEvent>*) override
+    {
+        if (a_event && !a_event->loaded) {
+            std::lock_guard lock(mutex);
+            actors.erase(a_event->formID);
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+private:
+    struct LiveEffect
+    {
+        std::uint16_t uniqueID;
+        std::uint8_t  slot;
+    };
+
+    struct Entry
+    {
+        std::array<std::uint16_t, maxTracked> counts{};
+        std::vector<LiveEffect>               live;
+    };
+
+    std::size_t GetSlot(const RE::EffectSetting* a_effect) const
+    {
+        for (std::size_t i = 0; i < trackedCount; ++i) {
+            if (tracked[i] == a_effect) {
+                return i;
+            }
+        }
+        return maxTracked;
+    }
+
+    Entry Seed(RE::Actor* a_actor) const
+    {
+        Entry entry;
+        auto  activeEffects = a_actor->AsMagicTarget()->GetActiveEffectList();
+        if (!activeEffects) {
+            return entry;
+        }
+        for (auto& effect : *activeEffects) {
+            if (!effect) {
+                continue;
+            }
+            if (const auto slot = GetSlot(effect->GetBaseObject()); slot != maxTracked) {
+                entry.live.push_back({ effect->usUniqueID, static_cast<std::uint8_t>(slot) });
+                ++entry.counts[slot];
+            }
+        }
+        return entry;
+    }
+
+    static std::optional<RE::EffectSetting*> FindUnique(RE::Actor* a_actor, std::uint16_t a_uniqueID)
+    {
+        auto activeEffects = a_actor->AsMagicTarget()->GetActiveEffectList();
+        if (!activeEffects) {
+            return std::nullopt;
+        }
+        for (auto& effect : *activeEffects) {
+            if (effect && effect->usUniqueID == a_uniqueID) {
+                return effect->GetBaseObject();
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::mutex                                 mutex;
+    std::array<RE::EffectSetting*, maxTracked> tracked{};
+    std::size_t                                trackedCount{ 0 };
+    std::unordered_map<RE::FormID, Entry>      actors;
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include "Cache.h"
+#include "Core/SpatialGrid.h"
+
+// Per-frame grid of high process actors (+ the player) used by the nearby actor conditions.
+// UpdateManager invalidates it every frame, the first query afterwards rebuilds it once.
+// Living actor counts are memoized per (origin, radius) until the next frame tick, so every
+// damage hook asking "how many around the player" in the same frame shares one grid query.
+class ActorSpatialIndex
+{
+public:
+    using Grid  = Core::SpatialGrid<RE::Actor*>;
+    using Entry = Grid::Entry;
+
+    static ActorSpatialIndex* GetSingleton()
+    {
+        static ActorSpatialIndex singleton;
+        return &singleton;
+    }
+
+    void Invalidate()
+    {
+        std::lock_guard lock(mutex);
+        stale = true;
+        countCache.clear();
+    }
+
+    std::int32_t CountAlive(RE::TESObjectREFR* a_ref, float a_radius, bool a_ignorePlayer)
+    {
+        std::lock_guard lock(mutex);
+        for (const auto& cached : countCache) {
+            if (cached.origin == a_ref && cached.radius == a_radius && cached.ignorePlayer == a_ignorePlayer) {
+                return cached.count;
+            }
+        }
+
+        std::int32_t count = 0;
+        ForEachNearbyLocked(a_ref, a_radius, a_ignorePlayer, [&](RE::Actor* a_actor) {
+            if (!a_actor->IsDead()) {
+                count++;
+            }
+        });
+        countCache.push_back({ a_ref, a_radius, a_ignorePlayer, count });
+        return count;
+    }
+
+    // Calls a_func(RE::Actor*) for every indexed actor within a_radius of a_ref, a_ref itself excluded
+    template <typename F>
+    void ForEachNearby(RE::TESObjectREFR* a_ref, float a_radius, bool a_ignorePlayer, F&& a_func)
+    {
+        std::lock_guard lock(mutex);
+        ForEachNearbyLocked(a_ref, a_radius, a_ignorePlayer, std::forward<F>(a_func));
+    }
+
+private:
+    struct CachedCount
+    {
+        RE::TESObjectREFR* origin;
+        float              radius;
+        bool               ignorePlayer;
+        std::int32_t       count;
+    };
+
+    ActorSpatialIndex() = default;
+
+    template <typename F>
+    void ForEachNearbyLocked(RE::TESObjectREFR* a_ref, float a_radius, bool a_ignorePlayer, F&& a_func)
+    {
+        RebuildIfStale();
+
+        const auto originPos = a_ref->GetPosition();
+        const auto player    = Cache::GetPlayerSingleton();
+
+        grid.ForEachWithin(originPos.x, originPos.y, originPos.z, a_radius, [&](const Entry& a_entry) {
+            if (a_entry.value == a_ref || (a_ignorePlayer && a_entry.value == player)) {
+                return;
+            }
+            a_func(a_entry.value);
+        });
+    }
+
+    void RebuildIfStale()
+    {
+        if (!stale) {
+            return;
+        }
+        stale = false;
+        grid.Clear();
+
+        if (const auto processLists = RE::ProcessLists::GetSingleton(); processLists) {
+            for (auto& actorHandle : processLists->highActorHandles) {
+                if (const auto actor = actorHandle.get(); actor) {
+                    const auto pos = actor->GetPosition();
+                    grid.Add(pos.x, pos.y, pos.z, actor.get());
+                }
+            }
+        }
+        if (const auto player = Cache::GetPlayerSingleton(); player) {
+            const auto pos = player->GetPosition();
+            grid.Add(pos.x, pos.y, pos.z, player);
+        }
+        grid.Build();
+    }
+
+    std::mutex               mutex;
+    bool                     stale{ true };
+    std::vector<CachedCount> countCache;
+    // cells the size of the pit fighter radius keep the common 500 unit query at 3x3 cells
+    Grid                     grid{ 500.0f };
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include "Cache.h"
+#include "Core/UpdateTiers.h"
+
+// Decides which characters the per-NPC update hook does its work for on a frame.
+// Actors in combat or within fActorUpdateNearRadius of the player every frame, actors within
+// fActorUpdateFarRadius every iActorUpdateMidInterval frames (phases spread by form id), actors further out
+// only after a combat state change or an active effect apply/remove on them. The frame hook calls
+// BeginFrame(), the per-tier counts of the previous frame are in LastFrame() and go to the debug
+// log every ten seconds.
+class ActorUpdateScheduler :
+    public RE::BSTEventSink<RE::TESCombatEvent>,
+    public RE::BSTEventSink<RE::TESActiveEffectApplyRemoveEvent>
+{
+public:
+    static ActorUpdateScheduler* GetSingleton()
+    {
+        static ActorUpdateScheduler singleton;
+        return &singleton;
+    }
+
+    void Register()
+    {
+        if (const auto holder = RE::ScriptEventSourceHolder::GetSingleton()) {
+            holder->AddEventSink<RE::TESCombatEvent>(this);
+            holder->AddEventSink<RE::TESActiveEffectApplyRemoveEvent>(this);
+            logger::info("Registered {}"sv, typeid(RE::TESCombatEvent).name());
+            logger::info("Registered {}"sv, typeid(RE::TESActiveEffectApplyRemoveEvent).name());
+        }
+    }
+
+    bool ShouldUpdate(RE::Character* a_actor)
+    {
+        const auto& config = Settings::Values();
+        const Core::UpdateTierSettings tiers{ config.actorUpdateNearRadius, config.actorUpdateFarRadius, config.actorUpdateMidInterval };
+
+        const auto player   = Cache::GetPlayerSingleton();
+        const auto distance = player ? a_actor->GetPosition().GetSquaredDistance(player->GetPosition()) : 0.0f;
+        const auto tier     = Core::UpdateTierScheduler::Classify(tiers, distance, a_actor->IsInCombat());
+
+        // no lock at all while nothing is marked, which is most frames
+        bool changed = false;
+        if (tier != Core::UpdateTier::kNear && marked.load(std::memory_order_relaxed)) {
+            std::lock_guard lock(mutex);
+            changed = changedActors.erase(a_actor->GetFormID()) > 0;
+            marked.store(changedActors.size(), std::memory_order_relaxed);
+        }
+        return scheduler.ShouldService(tiers, tier, a_actor->GetFormID(), changed);
+    }
+
+    // Called from the frame hook on the main thread
+    void BeginFrame()
+    {
+        scheduler.BeginFrame();
+        const auto now = frames.fetch_add(1, std::memory_order_relaxed) + 1;
+        // a loaded actor takes its mark on its next update, what is left after a whole frame
+        // belongs to actors that are not updated (unloaded) and only keeps the gate open
+        if (marked.load(std::memory_order_relaxed)) {
+            std::lock_guard lock(mutex);
+            std::erase_if(changedActors, [now](const auto& a_entry) { return now - a_entry.second > 2; });
+            marked.store(changedActors.size(), std::memory_order_relaxed);
+        }
+        if (now % logFrames == 0) {
+            const auto& last = scheduler.LastFrame();
+            dlog("[actor update] near {}/{}, mid {}/{}, far {}/{} serviced/loaded", last.serviced[0], last.seen[0], last.serviced[1], last.seen[1],
+                 last.serviced[2], last.seen[2]);
+        }
+    }
+
+    const Core::UpdateTierCounts& LastFrame() const noexcept { return scheduler.LastFrame(); }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESCombatEvent* a_event, RE::BSTEventSource<RE::TESCombatEvent>*) override
+    {
+        if (a_event && a_event->actor) {
+            MarkChanged(a_event->actor->GetFormID());
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESActiveEffectApplyRemoveEvent* a_event,
+                                          RE::BSTEventSource<RE::TESActiveEffectApplyRemoveEvent>*) override
+    {
+        if (a_event && a_event->target) {
+            MarkChanged(a_event->target->GetFormID());
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+private:
+    // about ten seconds at 60 fps
+    static constexpr std::uint32_t logFrames = 600;
+
+    ActorUpdateScheduler() = default;
+
+    void MarkChanged(RE::FormID a_formID)
+    {
+        std::lock_guard lock(mutex);
+        changedActors[a_formID] = frames.load(std::memory_order_relaxed);
+        marked.store(changedActors.size(), std::memory_order_relaxed);
+    }
+
+    Core::UpdateTierScheduler                     scheduler;
+    std::mutex                                    mutex;
+    std::unordered_map<RE::FormID, std::uint32_t> changedActors; // frame the mark was set on
+    std::atomic<std::size_t>                      marked{ 0 };
+    std::atomic<std::uint32_t>                    frames{ 0 };
+};
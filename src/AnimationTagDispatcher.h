@@ -0,0 +1,54 @@
+#pragma once
+
+// Routes animation graph events from the character vtable hooks to the handlers registered for
+// their tag. Tags are BSFixedStrings, interned in the engine's string pool, so two equal tags
+// share one data pointer: the registered strings are kept alive here and an event is looked up
+// by its tag pointer, a miss (footsteps, IK and every other tag we don't care about) costs a
+// single pointer keyed lookup instead of a strcmp chain.
+// Handlers are registered once at kDataLoaded before any graph event fires, dispatching only
+// reads the table afterwards, so it needs no lock across the animation threads.
+class AnimationTagDispatcher
+{
+public:
+    using Handler = std::function<void(RE::Actor*, const RE::BSAnimationGraphEvent&)>;
+
+    static AnimationTagDispatcher* GetSingleton()
+    {
+        static AnimationTagDispatcher singleton;
+        return &singleton;
+    }
+
+    void Register(std::string_view a_tag, Handler a_handler)
+    {
+        RE::BSFixedString tag{ a_tag };
+        auto&             slot = handlers[tag.data()];
+        if (slot.empty()) {
+            tags.push_back(std::move(tag));
+        }
+        slot.push_back(std::move(a_handler));
+    }
+
+    void Dispatch(const RE::BSAnimationGraphEvent& a_event) const
+    {
+        if (a_event.tag.empty() || !a_event.holder) {
+            return;
+        }
+        const auto it = handlers.find(a_event.tag.data());
+        if (it == handlers.end()) {
+            return;
+        }
+        auto actor = const_cast<RE::TESObjectREFR*>(a_event.holder)->As<RE::Actor>();
+        if (!actor) {
+            return;
+        }
+        for (const auto& handler : it->second) {
+            handler(actor, a_event);
+        }
+    }
+
+    std::size_t NumTags() const noexcept { return tags.size(); }
+
+private:
+    std::vector<RE::BSFixedString>                        tags;
+    std::unordered_map<const char*, std::vector<Handler>> handlers;
+};
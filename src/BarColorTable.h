@@ -0,0 +1,129 @@
+#pragma once
+#include "Conditions.h"
+
+// Stamina bar colour state of every actor TrueHUD may draw a bar for.
+// The per-actor update hook and UpdateManager only record whether the bar should be greyed out,
+// an actor whose wanted state differs from the applied one goes on a dirty list, and the frame
+// hook flushes only that list, so the TrueHUD override/revert calls are only made on transitions
+// and a frame without any costs nothing.
+// Entries live while their actor is loaded: far actors are only updated after an event (see
+// ActorUpdateScheduler), so a quiet entry can still be the current state of a greyed bar.
+// Unloading the actor reverts its bar and drops the entry, loading a save or starting a new game
+// drops them all.
+class BarColorTable : public RE::BSTEventSink<RE::TESObjectLoadedEvent>
+{
+public:
+    static BarColorTable* GetSingleton()
+    {
+        static BarColorTable singleton;
+        return &singleton;
+    }
+
+    void Register()
+    {
+        if (const auto holder = RE::ScriptEventSourceHolder::GetSingleton()) {
+            holder->AddEventSink<RE::TESObjectLoadedEvent>(this);
+            logger::info("Registered {} for stamina bar colours"sv, typeid(RE::TESObjectLoadedEvent).name());
+        }
+    }
+
+    void SetGreyedOut(RE::Actor* a_actor, bool a_greyedOut)
+    {
+        if (!Settings::TrueHudAPI_Obtained || !a_actor) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        const auto      formID = a_actor->GetFormID();
+        auto            it     = entries.find(formID);
+        if (it == entries.end()) {
+            // a bar that was never greyed out needs no entry
+            if (!a_greyedOut) {
+                return;
+            }
+            it = entries.emplace(formID, Entry{ a_actor->GetHandle() }).first;
+        }
+        auto& entry  = it->second;
+        entry.wanted = a_greyedOut;
+        entry.unload = false;
+        MarkDirty(formID, entry);
+    }
+
+    void Flush()
+    {
+        if (!Settings::TrueHudAPI_Obtained) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        for (const auto formID : dirty) {
+            const auto it = entries.find(formID);
+            if (it == entries.end()) {
+                continue;
+            }
+            auto&      entry = it->second;
+            const auto actor = entry.handle.get();
+            entry.queued     = false;
+
+            if (!actor) {
+                entries.erase(it);
+                continue;
+            }
+            if (entry.wanted != entry.applied) {
+                if (entry.wanted) {
+                    Conditions::greyoutAvMeter(actor.get(), RE::ActorValue::kStamina);
+                }
+                else {
+                    Conditions::revertAvMeter(actor.get(), RE::ActorValue::kStamina);
+                }
+                entry.applied = entry.wanted;
+            }
+            if (entry.unload || !entry.applied) {
+                entries.erase(it);
+            }
+        }
+        dirty.clear();
+    }
+
+    void Clear()
+    {
+        std::lock_guard lock(mutex);
+        entries.clear();
+        dirty.clear();
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESObjectLoadedEvent* a_event, RE::BSTEventSource<RE::TESObjectLoadedEvent>*) override
+    {
+        if (a_event && !a_event->loaded) {
+            std::lock_guard lock(mutex);
+            if (const auto it = entries.find(a_event->formID); it != entries.end()) {
+                // reverted and dropped on the next flush
+                it->second.wanted = false;
+                it->second.unload = true;
+                MarkDirty(a_event->formID, it->second);
+            }
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+private:
+    struct Entry
+    {
+        RE::ActorHandle handle;
+        bool            wanted{ false };
+        bool            applied{ false };
+        bool            unload{ false };
+        bool            queued{ false };
+    };
+
+    // called with the lock held
+    void MarkDirty(RE::FormID a_formID, Entry& a_entry)
+    {
+        if (!a_entry.queued && (a_entry.wanted != a_entry.applied || a_entry.unload)) {
+            a_entry.queued = true;
+            dirty.push_back(a_formID);
+        }
+    }
+
+    std::mutex                            mutex;
+    std::unordered_map<RE::FormID, Entry> entries;
+    std::vector<RE::FormID>               dirty;
+};
@@ -1,34 +1,27 @@
 #pragma once
+#include "ActiveEffectIndex.h"
+#include "ActorSpatialIndex.h"
 #include "Cache.h"
 #include "Settings.h"
 #include "Hooks.h"
+#include "Jobs.h"
 #include "API/TrueHUDAPI.h"
+#include "Core/CombatRules.h"
+#include "Core/Random.h"
 #include <numbers>
 
 // Originally intended to just implement some condition functions but iv been placing extensions/utility here as well
 namespace Conditions
 {
+    // per thread xoshiro state, see Core::ThreadRng, safe to call from task lambdas
     inline static int GetRandomINT(int a_min, int a_max)
     {
-        static std::random_device       rd;
-        static std::mt19937             gen(rd());
-        std::uniform_int_distribution<int> distrib(a_min, a_max);
-        return distrib(gen);
+        return Core::ThreadRng().UniformInt(a_min, a_max);
     }
 
     inline static double GetRandomDouble(double a_min, double a_max)
     {
-        static std::random_device       rd;
-        static std::mt19937             gen(rd());
-        std::uniform_real_distribution<> distrib(a_min, a_max);
-        return distrib(gen);
-    }
-
-    inline static float GetPointInRange(double radius, float start_point) 
-    {
-        float r = radius * std::sqrt((float)GetRandomDouble(0.0f, 1.0f));
-        auto theta = (float)GetRandomDouble(0.0f, 1.0f) * 2.0f * std::numbers::pi_v<float>;
-        return start_point + r * std::cos(theta);
+        return Core::ThreadRng().UniformDouble(a_min, a_max);
     }
 
     static bool IsAttacking(RE::Actor* actor)
@@ -74,35 +67,12 @@ namespace Conditions
     }
 
     inline static bool ActorHasActiveEffect(RE::Actor* a_actor, RE::EffectSetting* a_effect) {
-
-        auto               activeEffects = a_actor->AsMagicTarget()->GetActiveEffectList();
-        RE::EffectSetting* setting       = nullptr;
-        for (auto& effect : *activeEffects) {
-            setting = effect ? effect->GetBaseObject() : nullptr;
-            if (setting) {
-                if (setting == a_effect) {
-                    return true;
-                }
-            }
-        }
-        return false;
+        return ActiveEffectIndex::GetSingleton()->Has(a_actor, a_effect);
     }
 
     inline static bool PlayerHasActiveMagicEffect(RE::EffectSetting* a_effect)
     {
-        auto player = RE::PlayerCharacter::GetSingleton();
-
-        auto               activeEffects = player->AsMagicTarget()->GetActiveEffectList();
-        RE::EffectSetting* setting       = nullptr;
-        for (auto& effect : *activeEffects) {
-            setting = effect ? effect->GetBaseObject() : nullptr;
-            if (setting) {
-                if (setting == a_effect) {
-                    return true;
-                }
-            }
-        }
-        return false;
+        return ActiveEffectIndex::GetSingleton()->Has(RE::PlayerCharacter::GetSingleton(), a_effect);
     }
 
     inline static float GetMaxHealth()
@@ -156,13 +126,30 @@ namespace Conditions
         return nullptr;
     }
 
+    inline static Core::WeaponClass GetWeaponClass(RE::TESObjectWEAP* a_weapon)
+    {
+        if (a_weapon->IsOneHandedSword() || a_weapon->IsOneHandedAxe() || a_weapon->IsOneHandedMace()) {
+            return Core::WeaponClass::kOneHanded;
+        }
+        if (a_weapon->IsTwoHandedSword() || a_weapon->IsTwoHandedAxe()) {
+            return Core::WeaponClass::kTwoHanded;
+        }
+        if (a_weapon->IsOneHandedDagger()) {
+            return Core::WeaponClass::kDagger;
+        }
+        if (a_weapon->IsHandToHandMelee()) {
+            return Core::WeaponClass::kHandToHand;
+        }
+        return Core::WeaponClass::kOther;
+    }
+
     inline static bool IsDualWielding(RE::Actor* a_actor)
     {
         auto weapon = a_actor->GetAttackingWeapon();
         auto rhs    = a_actor->GetEquippedObject(false);
         auto lhs    = a_actor->GetEquippedObject(true);
         if (weapon && rhs && lhs && lhs->IsWeapon() && rhs->IsWeapon()) {
-            logger::debug("dual wielding is active");
+            dlog("dual wielding is active");
             return true;
         }
         else
@@ -171,84 +158,15 @@ namespace Conditions
 
     inline static std::vector<RE::Actor*> GetNearbyActors(RE::TESObjectREFR* a_ref, float a_radius, bool a_ignorePlayer)
     {
-        {
-            std::vector<RE::Actor*> result;
-            if (const auto processLists = RE::ProcessLists::GetSingleton(); processLists) {
-                if (a_ignorePlayer && processLists->numberHighActors == 0) {
-                    dlog("no process list");
-                    return result;
-                }
-
-                const auto squaredRadius = a_radius * a_radius;
-                const auto originPos     = a_ref->GetPosition();
-
-                result.reserve(processLists->numberHighActors);
-
-                const auto get_actor_within_radius = [&](RE::Actor* a_actor) {
-                    if (a_actor && a_actor != a_ref && originPos.GetSquaredDistance(a_actor->GetPosition()) <= squaredRadius) {
-                        result.emplace_back(a_actor);
-                    }
-                };
-                for (auto& actorHandle : processLists->highActorHandles) {
-                    const auto actor = actorHandle.get();
-                    get_actor_within_radius(actor.get());
-                }
-
-                if (!a_ignorePlayer) {
-                    get_actor_within_radius(Cache::GetPlayerSingleton());
-                }
-
-                if (!result.empty()) {
-                    dlog("vector is not empty");
-                    return result;
-                }
-            }
-            return result;
-        }
+        std::vector<RE::Actor*> result;
+        ActorSpatialIndex::GetSingleton()->ForEachNearby(a_ref, a_radius, a_ignorePlayer, [&](RE::Actor* a_actor) { result.emplace_back(a_actor); });
+        return result;
     }
 
+    // Memoized until the next frame, repeated queries from the damage hooks are free
     inline static std::int32_t NumNearbyActors(RE::TESObjectREFR* a_ref, float a_radius, bool a_ignorePlayer)
     {
-        {
-            std::int32_t num_result = 0;
-            
-            if (const auto processLists = RE::ProcessLists::GetSingleton(); processLists) {
-                if (a_ignorePlayer && processLists->numberHighActors == 0) {
-                    dlog("no process list");
-                    return num_result;
-                }
-
-                const auto squaredRadius = a_radius * a_radius;
-                const auto originPos     = a_ref->GetPosition();
-
-                std::vector<RE::Actor*> result;
-                result.reserve(processLists->numberHighActors);
-
-                const auto get_actor_within_radius = [&](RE::Actor* a_actor) {
-                    if (a_actor && a_actor != a_ref && originPos.GetSquaredDistance(a_actor->GetPosition()) <= squaredRadius) {
-                        result.emplace_back(a_actor);
-                    }
-                    };
-                for (auto& actorHandle : processLists->highActorHandles) {
-                    const auto actor = actorHandle.get();
-                    get_actor_within_radius(actor.get());
-                }
-
-                if (!a_ignorePlayer) {
-                    get_actor_within_radius(Cache::GetPlayerSingleton());
-                }
-
-                if (!result.empty()) {
-                    for (const auto& enemy : result) {
-                        if (enemy && !enemy->IsDead()) {
-                            num_result++;
-                        }
-                    }
-                    return num_result;
-                }
-            }
-            return num_result;
-        }
+        return ActorSpatialIndex::GetSingleton()->CountAlive(a_ref, a_radius, a_ignorePlayer);
     }
 
     // credits: https://github.com/Sacralletius/ANDR_SKSEFunctions currently unused though
@@ -285,7 +203,7 @@ namespace Conditions
 
     inline static void LaunchExtraArrow(RE::Actor* a_actor, RE::TESAmmo* a_ammo, RE::TESObjectWEAP* a_weapon, RE::BSFixedString a_nodeName, std::int32_t a_source, RE::TESObjectREFR* a_target, RE::AlchemyItem* a_poison)
     {     
-        SKSE::GetTaskInterface()->AddTask([a_actor, a_ammo, a_weapon, a_nodeName, a_source, a_target, a_poison]() {
+        Jobs::Commit([a_actor, a_ammo, a_weapon, a_nodeName, a_source, a_target, a_poison]() {
             RE::NiAVObject* fireNode = nullptr;
             auto            root = a_actor->IsPlayerRef() ? a_actor->GetCurrent3D() : a_actor->Get3D2();
             switch (a_source) {
@@ -354,63 +272,9 @@ namespace Conditions
 
     }
 
-    inline static void ArrowRain(RE::Actor* a_shooterForLevel, RE::Actor* a_Source, RE::TESAmmo* a_arrow, RE::Actor* start_actor, RE::Actor* target, int range, float extra_height, RE::AlchemyItem* a_poison)
-    {
-        
-
-        RE::NiPoint3 StartPos;
-        StartPos.x = start_actor->GetPositionX();
-        StartPos.y = start_actor->GetPositionY();
-        StartPos.z = start_actor->GetPositionZ() + extra_height;
-
-        RE::NiPoint3 EndPos;
-
-        EndPos.x = GetPointInRange(range, target->GetPositionX());
-        EndPos.y = GetPointInRange(range, target->GetPositionY());
-        EndPos.z = target->GetPositionZ();
-        //logger::debug("end position is: \ X:{} \n Y:{} \n Z:{}", EndPos.x, EndPos.y, EndPos.z);
-
-        auto rot = rot_at(StartPos, EndPos);
-
-        RE::Projectile::LaunchData ldata;
-        ldata.origin                = StartPos;
-        ldata.contactNormal         = { 0.0f, 0.0f, 0.0f };
-        ldata.projectileBase        = a_arrow->GetRuntimeData().data.projectile;
-        ldata.shooter               = a_Source;
-        ldata.combatController      = a_Source->GetActorRuntimeData().combatController;
-        ldata.weaponSource          = getWieldingWeapon(a_Source);
-        ldata.ammoSource            = a_arrow;
-        ldata.angleZ                = rot.z;
-        ldata.angleX                = rot.x;
-        ldata.unk50                 = nullptr;
-        ldata.desiredTarget         = target;
-        ldata.unk60                 = 0.0f;
-        ldata.unk64                 = 0.0f;
-        ldata.parentCell            = a_Source->GetParentCell();
-        ldata.spell                 = nullptr;
-        ldata.castingSource         = RE::MagicSystem::CastingSource::kOther;
-        ldata.pad7C                 = 0;
-        ldata.enchantItem           = nullptr;
-        ldata.poison                = a_poison;
-        ldata.area                  = 0;
-        ldata.power                 = 1.0f;
-        ldata.scale                 = 1.0f;
-        ldata.alwaysHit             = false;
-        ldata.noDamageOutsideCombat = false;
-        ldata.autoAim               = false;
-        ldata.chainShatter          = false;
-        ldata.useOrigin             = true;
-        ldata.deferInitialization   = false;
-        ldata.forceConeOfFire       = false;
-        RE::BSPointerHandle<RE::Projectile> handle;
-        RE::Projectile::Launch(&handle, ldata);
-            
-        
-    }
-
     inline void LaunchFireMeteores(RE::Actor* a_actor, RE::SpellItem* a_spell, RE::TESObjectREFR* a_target, float a_area)
     {
-        SKSE::GetTaskInterface()->AddTask([a_actor, a_spell, a_target, a_area]() {
+        Jobs::Commit([a_actor, a_spell, a_target, a_area]() {
 
             RE::NiPoint3 NodePosition;
 
@@ -418,7 +282,7 @@ namespace Conditions
             NodePosition.y = a_target->GetPositionY();
             NodePosition.z = a_target->GetPositionZ() + 600;
 
-            logger::debug("NodePosition: X = {}, Y = {}, Z = {}.", NodePosition.x, NodePosition.y, NodePosition.z);
+            dlog("NodePosition: X = {}, Y = {}, Z = {}.", NodePosition.x, NodePosition.y, NodePosition.z);
 
             RE::NiPoint3 DestinationPosition;
 
@@ -426,7 +290,7 @@ namespace Conditions
             DestinationPosition.y = a_target->GetPositionY() + GetRandomINT(0, a_area);
             DestinationPosition.z = a_target->GetPositionZ();
 
-            logger::debug("DestinationPosition: X = {}, Y = {}, Z = {}.", DestinationPosition.x, DestinationPosition.y, DestinationPosition.z);
+            dlog("DestinationPosition: X = {}, Y = {}, Z = {}.", DestinationPosition.x, DestinationPosition.y, DestinationPosition.z);
 
             auto rot = rot_at(NodePosition, DestinationPosition);
 
@@ -482,7 +346,7 @@ namespace Conditions
         NodePosition.y = StartPoint_Y;
         NodePosition.z = StartPoint_Z;
 
-        logger::debug("NodePosition: X = {}, Y = {}, Z = {}.", NodePosition.x, NodePosition.y, NodePosition.z);
+        dlog("NodePosition: X = {}, Y = {}, Z = {}.", NodePosition.x, NodePosition.y, NodePosition.z);
 
         RE::NiPoint3 DestinationPosition;
 
@@ -490,7 +354,7 @@ namespace Conditions
         DestinationPosition.y = EndPoint_Y;
         DestinationPosition.z = EndPoint_Z;
 
-        logger::debug("DestinationPosition: X = {}, Y = {}, Z = {}.", DestinationPosition.x, DestinationPosition.y, DestinationPosition.z);
+        dlog("DestinationPosition: X = {}, Y = {}, Z = {}.", DestinationPosition.x, DestinationPosition.y, DestinationPosition.z);
 
         auto rot = rot_at(NodePosition, DestinationPosition);
 
@@ -1,8 +1,15 @@
 #pragma once
 #include <Conditions.h>
+#include <Core/HitDedupRing.h>
+#include <HookProfiler.h>
 #include <Hooks.h>
 #include <InputHandler.h>
-#include <RecentHitEventData.h>
+#include <ParryResolver.h>
+#include <AnimationTagDispatcher.h>
+#include <PlayerStateTracker.h>
+#include <TelemetryRecorder.h>
+#include <VolleyLauncher.h>
+#include <WeaponStaminaProfiles.h>
 
 using EventResult = RE::BSEventNotifyControl;
 
@@ -10,7 +17,7 @@ class OnHitEventHandler : public RE::BSTEventSink<RE::TESHitEvent>
 {
 public:
     std::atomic_bool do_once = false;
-    std::multimap<std::uint32_t, RecentHitEventData> recentGeneralHits;
+    Core::HitDedupRing<> recentHits;
 
     static OnHitEventHandler* GetSingleton()
     {
@@ -28,8 +35,9 @@ public:
     EventResult ProcessEvent(const RE::TESHitEvent* a_event, [[maybe_unused]] RE::BSTEventSource<RE::TESHitEvent>* a_eventSource) override
     {
         using HitFlag = RE::TESHitEvent::Flag;
+        HookProfiler::Scope profile(HookProfiler::Probe::kHitEvent);
         if (!a_event || !a_event->target || !a_event->cause || a_event->projectile) {
-            logger::debug("no target, no event, no cause");
+            dlog("no target, no event, no cause");
             return continueEvent;
         }
         auto defender = a_event->target ? a_event->target->As<RE::Actor>() : nullptr;
@@ -42,6 +50,15 @@ public:
             dlog("no aggressor");
             return continueEvent;
         }
+        if (ShouldSkipHitEvent(aggressor, defender, a_event->source, GetDurationOfApplicationRunTime())) {
+            dlog("duplicate hit event");
+            return continueEvent;
+        }
+        if (auto telemetry = TelemetryRecorder::GetSingleton(); telemetry->Active()) {
+            const auto flags = static_cast<std::uint8_t>(a_event->flags.any(HitFlag::kBashAttack) | a_event->flags.any(HitFlag::kPowerAttack) << 1
+                                                         | a_event->flags.any(HitFlag::kHitBlocked) << 2);
+            telemetry->Record(Core::TelemetryKind::kHit, flags, { defender->IsPlayerRef() ? 1.0f : 0.0f }, 0.0f);
+        }
         // Credits: https://github.com/colinswrath/handtohand/blob/main/src/Events.h for hand to hand event
 
 
@@ -61,7 +78,7 @@ public:
             }
             auto weap = Conditions::getWieldingWeapon(aggressor);
             if (weap->IsBow()) {
-                logger::debug("weapon is bow");
+                dlog("weapon is bow");
                 Settings* settings = Settings::GetSingleton();
                 /*if (!Conditions::ActorHasActiveEffect(aggressor, settings->ArrowRainCooldownEffect)) {
                     LaunchArrowRain(aggressor, defender, 800.0f);
@@ -69,7 +86,7 @@ public:
                 }*/               
             }
             if (a_event->flags.any(HitFlag::kHitBlocked) && a_event->target && !a_event->projectile) {
-                logger::debug("entered block event");
+                dlog("entered block event");
                 auto attacking_weap = RE::TESForm::LookupByID<RE::TESObjectWEAP>(a_event->source);
                 if (!defender || !attacking_weap || !defender->GetActorRuntimeData().currentProcess || !defender->GetActorRuntimeData().currentProcess->high
                     || !attacking_weap->IsMelee() || !defender->Get3D())
@@ -94,7 +111,7 @@ public:
                 if (leftHand && leftHand->IsArmor()) {
                     dlog("left hand is shield");
                     if (defender->IsPlayerRef()) {
-                        ProcessHitEventForParryShield(defender, aggressor);
+                        ParryResolver::GetSingleton()->Resolve(defender, aggressor, true);
                         PlaySparks(defender);
                     }
                     else {
@@ -106,7 +123,7 @@ public:
                     dlog("left hand is empty");
                     if (defender->IsPlayerRef()) {
                         dlog("blocker is player");
-                        ProcessHitEventForParry(defender, aggressor);
+                        ParryResolver::GetSingleton()->Resolve(defender, aggressor, false);
                         PlaySparks(defender);
                     }
                     else {
@@ -142,11 +159,10 @@ public:
         return continueEvent;
     }    
 
+    // LaunchExtraArrow already defers the launch to the start of the next frame
     void StartMultiShot(RE::Actor* attacker, RE::Actor* target) {
         auto weap = Conditions::getWieldingWeapon(attacker);
-        SKSE::GetTaskInterface()->AddTask([=] {
         Conditions::LaunchExtraArrow(attacker, attacker->GetCurrentAmmo(), weap, "", -1, target, nullptr);
-            });
     }
 
     void LaunchArrowRain(RE::Actor* attacker, RE::Actor* target, float a_area) {
@@ -157,63 +173,22 @@ public:
             if(attacker->HasPerk(settings->ArrowRainPerk) && !Conditions::ActorHasActiveEffect(attacker, settings->ArrowRainCooldownEffect))
             {
                 // separation needed to apply poisons to arrow rain
-                RE::PlayerCharacter* player = Cache::GetPlayerSingleton(); 
+                RE::PlayerCharacter* player = Cache::GetPlayerSingleton();
+                RE::AlchemyItem*     poison = nullptr;
                 if (attacker == player) {
                     Conditions::ApplySpell(attacker, attacker, settings->ArrowRainCooldownSpell);
-                    for (int i = 0; i < 75; i++) {
-                        SKSE::GetTaskInterface()->AddTask([=] {
-                            Conditions::ArrowRain(attacker, attacker, attacker->GetCurrentAmmo(), target, target, a_area, 500, player->GetInfoRuntimeData().pendingPoison);
-                            });                   
-                    }
+                    poison = player->GetInfoRuntimeData().pendingPoison;
                 }
                 else {
                     do_once = true;
-                    for (int i = 0; i < 75; i++) {
-                        SKSE::GetTaskInterface()->AddTask([=] {
-                            Conditions::ArrowRain(attacker, attacker, attacker->GetCurrentAmmo(), target, target, a_area, 500, nullptr);
-                            });                   
-                    }
                 }
+                VolleyLauncher::GetSingleton()->Launch(attacker, attacker->GetCurrentAmmo(), Conditions::getWieldingWeapon(attacker), poison, target, target,
+                                                       { 75, a_area, 500.0f, 0.0f });
             }
                         
         }
     }
 
-    void ProcessHitEventForParry(RE::Actor* target, RE::Actor* aggressor)
-    {
-        dlog("processHitEvent For Parry started");
-        auto settings = Settings::GetSingleton();
-        if (Conditions::PlayerHasActiveMagicEffect(settings->MAG_ParryWindowEffect)) {
-            dlog("condition is true");
-            dlog("range is {}", settings->surroundingActorsRange);
-            for (auto& actors : Conditions::GetNearbyActors(target, settings->surroundingActorsRange, false)) {
-                if (actors != aggressor) {
-                    Conditions::ApplySpell(target, actors, settings->MAGParryStaggerSpell);
-                    dlog("applied spell to {}", actors->GetName());
-                }
-            }
-            Conditions::ApplySpell(target, aggressor, settings->MAGParryStaggerSpell);
-            Conditions::ApplySpell(aggressor, target, settings->APOParryBuffSPell);
-            target->PlaceObjectAtMe(settings->APOSparksFlash, false);
-        }
-    }
-
-    void ProcessHitEventForParryShield(RE::Actor* target, RE::Actor* aggressor)
-    {
-        auto settings = Settings::GetSingleton();
-        if (Conditions::PlayerHasActiveMagicEffect(settings->MAG_ParryWindowEffect)) {
-            for (auto& actors : Conditions::GetNearbyActors(target, settings->surroundingActorsRange, false)) {
-                if (actors != aggressor) {
-                    Conditions::ApplySpell(target, actors, settings->MAGParryStaggerSpell);
-                    dlog("applied spell to {}", actors->GetName());
-                }
-            }
-            Conditions::ApplySpell(target, aggressor, settings->MAGParryStaggerSpell);
-            Conditions::ApplySpell(aggressor, target, settings->APOParryBuffSPell);
-            target->PlaceObjectAtMe(settings->APOSparksShieldFlash, false);
-        }
-    }
-
     void PlaySparks(RE::Actor* defender)
     {
         const Settings* settings = Settings::GetSingleton();
@@ -227,7 +202,8 @@ public:
 
         float HandToHandLevel = player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kLockpicking);
 
-        float baseXP = (Settings::BonusXPPerLevel * HandToHandLevel) + Settings::BaseXP;
+        const auto& config = Settings::Values();
+        float       baseXP = (config.bonusXPPerLevel * HandToHandLevel) + config.baseXP;
 
         player->AddSkillExperience(RE::ActorValue::kLockpicking, baseXP);
         dlog("[HAND TO HAND XP] granted {} of hand to hand experience", baseXP);
@@ -239,25 +215,16 @@ public:
         return MenuControls->InBeastForm();
     }
 
-    bool ShouldSkipHitEvent(RE::Actor* causeActor, RE::Actor* targetActor, std::uint32_t runTime)
+    // Credit: PAPER by Dennis Soemers used as reference
+    // The engine now and then reports the same hit twice, the second report of the same cause hitting
+    // the same target with the same weapon or spell within iHitDedupWindowMs is skipped. Off by default.
+    bool ShouldSkipHitEvent(RE::Actor* causeActor, RE::Actor* targetActor, RE::FormID source, std::uint32_t runTime)
     {
-        bool skipEvent = false;
-
-        auto matchedHits = recentGeneralHits.equal_range(runTime);
-        for (auto it = matchedHits.first; it != matchedHits.second; ++it) {
-            if (it->second.cause == causeActor && it->second.target == targetActor) {
-                skipEvent = true;
-                break;
-            }
-        }
-
-        auto upper = recentGeneralHits.lower_bound(runTime);
-        auto it    = recentGeneralHits.begin();
-        while (it != upper) {
-            it = recentGeneralHits.erase(it);
+        const auto window = Settings::Values().hitDedupWindowMs;
+        if (window < 0) {
+            return false;
         }
-
-        return skipEvent;
+        return recentHits.CheckAndRecord(causeActor->GetFormID(), targetActor->GetFormID(), source, runTime, static_cast<std::uint32_t>(window));
     }
 
     static void Register()
@@ -290,7 +257,8 @@ public:
 
     inline static void StaminaCost(RE::Actor* actor, double cost);
 
-    const char* jumpAnimEventString = "JumpUp";
+    // interned once, an event tag compares against it by pointer
+    const RE::BSFixedString jumpTag{ "JumpUp" };
 
     // Anims
 
@@ -318,7 +286,7 @@ public:
 
         if (!a_event->tag.empty() && a_event->holder && a_event->holder->As<RE::Actor>()) {
             // dlog("event is {}", a_event->tag.c_str());
-            if (std::strcmp(a_event->tag.c_str(), jumpAnimEventString) == 0) {
+            if (a_event->tag.data() == jumpTag.data()) {
                 if (a_event->holder && a_event->holder->As<RE::Actor>() && !IsInBeastRace()) {
                     HandleJumpAnim();
                     dlog("jump happened and player is a {} and the event is {}", a_event->holder->As<RE::Actor>()->GetRace()->GetName(), a_event->tag.c_str());
@@ -375,14 +343,17 @@ public:
         eventHolder->AddEventSink<RE::TESSwitchRaceCompleteEvent>(GetSingleton());
     }
 
-    static void RegisterAnimHook() { InstallHook(); }
+    static void RegisterAnimHook()
+    {
+        RegisterTagHandlers();
+        InstallHook();
+    }
 
 private:
-    inline static void ProcessJump(RE::BSTEventSink<RE::BSAnimationGraphEvent>* a_sink, RE::BSAnimationGraphEvent* a_event,
-                                   RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource);
+    static void RegisterTagHandlers();
 
-    inline static void ProcessEvent(RE::BSTEventSink<RE::BSAnimationGraphEvent>* a_sink, RE::BSAnimationGraphEvent* a_event,
-                                    RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource);
+    static void OnHitFrame(RE::Actor* actor);
+    static void OnDodgeStart(RE::Actor* actor);
 
     static EventResult ProcessEvent_NPC(RE::BSTEventSink<RE::BSAnimationGraphEvent>* a_sink, RE::BSAnimationGraphEvent* a_event,
                                         RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource);
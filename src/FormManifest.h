@@ -0,0 +1,122 @@
+#pragma once
+
+// Declarative table of the forms the plugin needs. Every entry names its plugin file, local
+// FormID and form type, optionally binds a pointer to fill, and can be overridden from the
+// [Forms] section of the ini ("Name = 0x123" or "Name = 0x123~Other.esp").
+// Resolve() looks every plugin file up once, builds the load order FormIDs itself and checks the
+// form type before assigning, so a missing or wrong form is logged and left null instead of
+// crashing on an unchecked As<>(). A missing required form fails the whole Resolve(), the
+// plugin reads those pointers without null checks.
+namespace FormManifest
+{
+    struct Entry
+    {
+        std::string   name;
+        std::string   plugin;
+        RE::FormID    localID;
+        RE::FormType  type;
+        void*         slot;
+        void          (*assign)(void*, RE::TESForm*);
+        bool          required;
+    };
+
+    template <class T>
+    Entry Bind(std::string_view a_name, std::string_view a_plugin, RE::FormID a_localID, T*& a_slot, bool a_required = true)
+    {
+        return { std::string(a_name), std::string(a_plugin), a_localID, T::FORMTYPE, &a_slot,
+                 [](void* a_out, RE::TESForm* a_form) { *static_cast<T**>(a_out) = static_cast<T*>(a_form); }, a_required };
+    }
+
+    inline void ApplyOverrides(std::vector<Entry>& a_entries, const char* a_iniPath)
+    {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        if (ini.LoadFile(a_iniPath) < 0) {
+            return;
+        }
+
+        for (auto& entry : a_entries) {
+            const char* value = ini.GetValue("Forms", entry.name.c_str());
+            if (!value || !*value) {
+                continue;
+            }
+            std::string_view str = value;
+            if (const auto tilde = str.find('~'); tilde != std::string_view::npos) {
+                entry.plugin = str.substr(tilde + 1);
+                str          = str.substr(0, tilde);
+            }
+            entry.localID = static_cast<RE::FormID>(std::strtoul(std::string(str).c_str(), nullptr, 16));
+            logger::info("form {} overridden to {:X}~{}", entry.name, entry.localID, entry.plugin);
+        }
+    }
+
+    // Same id math as TESDataHandler::LookupFormID, minus the mod lookup per form
+    inline RE::FormID ToLoadOrderID(const RE::TESFile* a_file, RE::FormID a_localID)
+    {
+        if (a_file->IsLight()) {
+            return 0xFE000000 | (static_cast<RE::FormID>(a_file->smallFileCompileIndex) << 12) | (a_localID & 0xFFF);
+        }
+        return (static_cast<RE::FormID>(a_file->compileIndex) << 24) | (a_localID & 0xFFFFFF);
+    }
+
+    // Returns false when a required entry was not found, every entry is still assigned
+    inline bool Resolve(std::vector<Entry>& a_entries, const char* a_iniPath)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        ApplyOverrides(a_entries, a_iniPath);
+
+        std::vector<Entry*> order;
+        order.reserve(a_entries.size());
+        for (auto& entry : a_entries) {
+            order.push_back(&entry);
+        }
+        std::ranges::stable_sort(order, {}, &Entry::plugin);
+
+        auto        dataHandler = RE::TESDataHandler::GetSingleton();
+        std::size_t files = 0, found = 0, missing = 0, missingRequired = 0;
+
+        const RE::TESFile* file = nullptr;
+        std::string_view   fileName;
+        for (auto entry : order) {
+            entry->assign(entry->slot, nullptr);
+            if (files == 0 || entry->plugin != fileName) {
+                fileName = entry->plugin;
+                file     = dataHandler->LookupModByName(fileName);
+                files++;
+                if (!file || file->compileIndex == 0xFF) {
+                    file = nullptr;
+                    logger::warn("plugin {} is not loaded", fileName);
+                }
+            }
+
+            RE::TESForm* form = file ? RE::TESForm::LookupByID(ToLoadOrderID(file, entry->localID)) : nullptr;
+            if (form && form->GetFormType() != entry->type) {
+                logger::error("form {} ({:X}~{}) is a {}, expected {}", entry->name, entry->localID, entry->plugin, RE::FormTypeToString(form->GetFormType()),
+                              RE::FormTypeToString(entry->type));
+                form = nullptr;
+            }
+
+            if (!form) {
+                missing++;
+                if (entry->required) {
+                    missingRequired++;
+                    logger::error("required form {} ({:X}~{}) not found", entry->name, entry->localID, entry->plugin);
+                }
+                else {
+                    dlog("optional form {} ({:X}~{}) not found", entry->name, entry->localID, entry->plugin);
+                }
+                continue;
+            }
+
+            found++;
+            entry->assign(entry->slot, form);
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logger::info("resolved {} of {} forms from {} plugins in {:.3f} ms", found, a_entries.size(), files, elapsed);
+        if (missing) {
+            logger::warn("{} forms missing, {} of them required", missing, missingRequired);
+        }
+        return missingRequired == 0;
+    }
+} // namespace FormManifest
@@ -0,0 +1,77 @@
+#pragma once
+
+// Typed handles for the game settings the patches read from engine callbacks.
+// GameSettingCollection::GetSetting is a string keyed hash lookup, so every handle is resolved
+// once after data load and again after a save is loaded, the hooks then only dereference a
+// pointer. A handle that is asked for before it was resolved is looked up on the spot.
+namespace GameSettings
+{
+    enum class ID : std::uint32_t
+    {
+        kStaminaBlockStaggerMult,
+        kStaminaBlockDmgMult,
+        kStaminaBlockBase,
+        kStaminaBashBase,
+        kStaminaPowerBashBase,
+        kStaminaAttackWeaponBase,
+        kStaminaAttackWeaponMult,
+        kPowerAttackStaminaPenalty,
+        kArmorScalingFactor,
+        kMaxArmorRating,
+        kCombatHitConeAngle,
+
+        kTotal
+    };
+
+    // clang-format off
+    inline constexpr std::array<const char*, static_cast<std::size_t>(ID::kTotal)> names{
+        "fStaminaBlockStaggerMult",
+        "fStaminaBlockDmgMult",
+        "fStaminaBlockBase",
+        "fStaminaBashBase",
+        "fStaminaPowerBashBase",
+        "fStaminaAttackWeaponBase",
+        "fStaminaAttackWeaponMult",
+        "fPowerAttackStaminaPenalty",
+        "fArmorScalingFactor",
+        "fMaxArmorRating",
+        "fCombatHitConeAngle",
+    };
+    // clang-format on
+
+    inline std::array<std::atomic<RE::Setting*>, static_cast<std::size_t>(ID::kTotal)> handles{};
+
+    inline RE::Setting* Lookup(ID a_id)
+    {
+        const auto index   = static_cast<std::size_t>(a_id);
+        auto       setting = RE::GameSettingCollection::GetSingleton()->GetSetting(names[index]);
+        handles[index].store(setting, std::memory_order_relaxed);
+        return setting;
+    }
+
+    inline void Resolve()
+    {
+        std::size_t missing = 0;
+        for (std::size_t i = 0; i < handles.size(); ++i) {
+            if (!Lookup(static_cast<ID>(i))) {
+                logger::error("game setting {} not found", names[i]);
+                missing++;
+            }
+        }
+        logger::info("resolved {} game settings", handles.size() - missing);
+    }
+
+    inline RE::Setting* Get(ID a_id)
+    {
+        if (auto setting = handles[static_cast<std::size_t>(a_id)].load(std::memory_order_relaxed)) {
+            return setting;
+        }
+        return Lookup(a_id);
+    }
+
+    inline float GetFloat(ID a_id)
+    {
+        const auto setting = Get(a_id);
+        return setting ? setting->GetFloat() : 0.0f;
+    }
+} // namespace GameSettings
@@ -0,0 +1,131 @@
+#pragma once
+#include "Core/CycleHistogram.h"
+
+// Per hook frame time accounting, off unless bProfileHooks is set. Every hook opens a Scope
+// around the work this plugin adds (the original engine call is left out), the frame hook calls
+// Tick() and every iProfileDumpSeconds the histograms are drained into
+// <SKSE logs>/paragon-perks-profile.csv, one row per hook with calls, mean, p50, p99 and max in
+// microseconds. A disabled Scope is one relaxed load and a branch.
+namespace HookProfiler
+{
+    enum class Probe : std::uint32_t
+    {
+        kFrameUpdate,
+        kActorUpdate,
+        kCombatDamage,
+        kBowDamage,
+        kCheckAddEffect,
+        kAnimationEvent,
+        kHitEvent,
+        kInput,
+        kParryLatency, // parry to its last queued stagger, spans frames
+        kJobCompute,   // one Jobs::Run computation on a worker
+        kJobCommit,    // applying the finished jobs at the start of a frame
+
+        kTotal
+    };
+
+    // clang-format off
+    inline constexpr std::array<const char*, static_cast<std::size_t>(Probe::kTotal)> names{
+        "FrameUpdate",
+        "ActorUpdate",
+        "CombatDamage",
+        "BowDamage",
+        "CheckAddEffect",
+        "AnimationEvent",
+        "HitEvent",
+        "Input",
+        "ParryLatency",
+        "JobCompute",
+        "JobCommit",
+    };
+    // clang-format on
+
+    inline std::array<Core::CycleHistogram, static_cast<std::size_t>(Probe::kTotal)> histograms;
+    inline std::atomic<bool>                                                          enabled{ false };
+    inline std::atomic<double>                                                        cyclesPerUs{ 0.0 };
+
+    class Scope : Core::ScopedCycles
+    {
+    public:
+        explicit Scope(Probe a_probe) noexcept :
+            Core::ScopedCycles(enabled.load(std::memory_order_relaxed) ? &histograms[static_cast<std::size_t>(a_probe)] : nullptr)
+        {}
+    };
+
+    // For spans a Scope cannot cover, a_cycles measured with Core::ReadCycles()
+    inline void Record(Probe a_probe, std::uint64_t a_cycles) noexcept
+    {
+        if (enabled.load(std::memory_order_relaxed)) {
+            histograms[static_cast<std::size_t>(a_probe)].Record(a_cycles);
+        }
+    }
+
+    // The first enable calibrates the tsc, a 20 ms sleep at plugin load or on the settings reload thread
+    inline void Enable(bool a_enable)
+    {
+        if (a_enable && cyclesPerUs.load(std::memory_order_relaxed) == 0.0) {
+            cyclesPerUs.store(Core::CalibrateCyclesPerNs() * 1000.0, std::memory_order_relaxed);
+        }
+        if (a_enable && !enabled.load(std::memory_order_relaxed)) {
+            // drop whatever was recorded by an earlier session of the profiler
+            for (auto& histogram : histograms) {
+                histogram.Drain();
+            }
+        }
+        enabled.store(a_enable, std::memory_order_relaxed);
+    }
+
+    inline void WriteRows(std::string a_rows)
+    {
+        static std::mutex writing;
+        static bool       headerWritten{ false };
+        std::lock_guard   lock(writing);
+
+        auto path = SKSE::log::log_directory();
+        if (!path) {
+            return;
+        }
+        *path /= "paragon-perks-profile.csv";
+
+        std::ofstream file(*path, headerWritten ? std::ios::app : std::ios::trunc);
+        if (!headerWritten) {
+            file << "seconds,hook,calls,mean_us,p50_us,p99_us,max_us\n";
+            headerWritten = true;
+        }
+        file << a_rows;
+    }
+
+    // Called from the frame hook on the main thread
+    inline void Tick(std::uint32_t a_dumpSeconds)
+    {
+        using clock = std::chrono::steady_clock;
+        static const auto        started  = clock::now();
+        static clock::time_point lastDump = started;
+
+        if (!enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const auto now = clock::now();
+        if (now - lastDump < std::chrono::seconds(std::max(a_dumpSeconds, 1u))) {
+            return;
+        }
+        lastDump = now;
+
+        const auto  seconds = std::chrono::duration<double>(now - started).count();
+        const auto  perUs   = cyclesPerUs.load(std::memory_order_relaxed);
+        std::string rows;
+        for (std::size_t i = 0; i < histograms.size(); ++i) {
+            const auto summary = histograms[i].Drain();
+            if (!summary.count) {
+                continue;
+            }
+            rows += fmt::format("{:.1f},{},{},{:.2f},{:.2f},{:.2f},{:.2f}\n", seconds, names[i], summary.count, summary.Mean() / perUs,
+                                summary.p50 / perUs, summary.p99 / perUs, summary.max / perUs);
+            dlog("[profile] {}: {} calls, p50 {:.2f} us, p99 {:.2f} us", names[i], summary.count, summary.p50 / perUs, summary.p99 / perUs);
+        }
+        if (!rows.empty()) {
+            std::thread(WriteRows, std::move(rows)).detach();
+        }
+    }
+} // namespace HookProfiler
@@ -1,8 +1,29 @@
+#include "ActorUpdateScheduler.h"
 #include "Events.h"
+#include "HookProfiler.h"
+#include "TelemetryRecorder.h"
 #include "UpdateManager.h"
 #include "patches/ArmorRatingScaling.h"
 #include "patches/BashBlockStaminaPatch.h"
 #include "patches/MiscPatches.h"
+#include "Core/CombatRules.h"
+
+namespace
+{
+    // all pit fighter hooks ask for the same radius so they hit the same per-frame cached count
+    constexpr float pitFighterRadius = 500.0f;
+
+    Core::PitFighterModifiers GetPitFighterModifiers()
+    {
+        return { Settings::dmgModifierMinEnemy, Settings::dmgModifierMidEnemy, Settings::dmgModifierMaxEnemy };
+    }
+
+    void RecordPitFighter(Core::TelemetryKind a_kind, float a_damage, std::int32_t a_enemies, const Core::PitFighterModifiers& a_modifiers, float a_result)
+    {
+        TelemetryRecorder::GetSingleton()->Record(a_kind, 0, { a_damage, static_cast<float>(a_enemies), a_modifiers.minEnemy, a_modifiers.midEnemy, a_modifiers.maxEnemy },
+                                                  a_result);
+    }
+} // namespace
 
 namespace Hooks
 {
@@ -24,7 +45,7 @@ namespace Hooks
         WeaponFireHandler::InstallArrowReleaseHook();
 
         auto runtime = REL::Module::GetRuntime();
-        if (Settings::GetSingleton()->armorScalingEnabled) {
+        if (Settings::Values().armorScalingEnabled) {
             if (runtime == REL::Module::Runtime::AE) {
                 logger::info("Installing ar hook AE");
                 ArmorRatingScaling::InstallArmorRatingHookAE();
@@ -62,13 +83,10 @@ namespace Hooks
 
     void ActorUpdateHook::ActorUpdate(RE::Character* a_this, float a_delta)
     {
-        Settings* settings = Settings::GetSingleton();
-        if (Conditions::ActorHasActiveEffect(a_this, settings->StaminaPenEffectNPC)) {
-            dlog("has effect, gray out meter");
-            Conditions::greyoutAvMeter(a_this, RE::ActorValue::kStamina);
-        }
-        else {
-            Conditions::revertAvMeter(a_this, RE::ActorValue::kStamina);
+        if (ActorUpdateScheduler::GetSingleton()->ShouldUpdate(a_this)) {
+            HookProfiler::Scope profile(HookProfiler::Probe::kActorUpdate);
+            Settings*           settings = Settings::GetSingleton();
+            BarColorTable::GetSingleton()->SetGreyedOut(a_this, Conditions::ActorHasActiveEffect(a_this, settings->StaminaPenEffectNPC));
         }
         return _ActorUpdate(a_this, a_delta);
     }
@@ -87,25 +105,24 @@ namespace Hooks
         RE::Actor* actor = skyrim_cast<RE::Actor*>(a);
 
         auto dam = _originalCall(_weap, a, DamageMult, isbow);
+        HookProfiler::Scope profile(HookProfiler::Probe::kCombatDamage);
         if (player->HasPerk(settings->PitFighterPerk)) {
             if (actor != player) {
                 return dam;
             }
 
-            if (Conditions::NumNearbyActors(player, 500.0f, false) > 0) {
-                dlog("first condition cehck, there are {} enemies", Conditions::NumNearbyActors(player, 500.0f, false));
+            std::int32_t enemyNum = Conditions::NumNearbyActors(player, pitFighterRadius, false);
+            if (enemyNum > 0) {
+                dlog("first condition cehck, there are {} enemies", enemyNum);
                 if (!isbow) {
-                    logger::debug("----------------------------------------------------");
-                    logger::debug("started hooked damage calc: {} was hit with {}", actor->GetName(), DamageMult);
-                    std::int32_t enemyNum = Conditions::NumNearbyActors(player, 500.0f, false);
+                    dlog("----------------------------------------------------");
+                    dlog("started hooked damage calc: {} was hit with {}", actor->GetName(), DamageMult);
                     dlog("{} is surrounded by {} enemies", player->GetDisplayFullName(), (int)enemyNum);
-                    if (enemyNum <= 2)
-                        dam *= Settings::dmgModifierMinEnemy;
-                    if (enemyNum == 3)
-                        dam *= Settings::dmgModifierMidEnemy;
-                    if (enemyNum >= 4)
-                        dam *= Settings::dmgModifierMaxEnemy;
-                    logger::debug("new damage for melee is {}. Original damage was: {} \n", dam, DamageMult); 
+                    const auto modifiers = GetPitFighterModifiers();
+                    const auto original  = dam;
+                    dam *= Core::GetPitFighterMeleeMult(modifiers, enemyNum);
+                    RecordPitFighter(Core::TelemetryKind::kPitFighterMelee, original, enemyNum, modifiers, dam);
+                    dlog("new damage for melee is {}. Original damage was: {} \n", dam, DamageMult); 
                     return dam;
                 }              
             }
@@ -126,25 +143,19 @@ namespace Hooks
         RE::PlayerCharacter* player = Cache::GetPlayerSingleton();
         Settings* settings = Settings::GetSingleton();
         auto dam = _originalCall(a1, a2);
+        HookProfiler::Scope profile(HookProfiler::Probe::kBowDamage);
         dlog("sanity check");
         dlog("a1 is {}", a1);
         dlog("a2 is {}", a2);
         dlog("pit fighter bow is hooked. dam is: {}", dam);
         if (player->IsInCombat() && player->HasPerk(settings->PitFighterPerk) && player->IsAttacking()) {
-            std::int32_t enemyNum = Conditions::NumNearbyActors(player, 500.0f, false);
+            std::int32_t enemyNum = Conditions::NumNearbyActors(player, pitFighterRadius, false);
             dlog("sanity check, enemy number is {}", enemyNum);
-            if (enemyNum >= 4) {                
-                dam *= Settings::dmgModifierMinEnemy;
-                dlog("return with more than 4 enemies, dam is {}", dam);
-            }                
-            if (enemyNum == 3){
-                dam *= Settings::dmgModifierMidEnemy;
-                dlog("return with 3 enemies, dam is {}", dam);
-            }                
-            if (enemyNum <= 2 ) {
-                dam *= Settings::dmgModifierMaxEnemy;
-                dlog("return with 2 or less enemies, dam is {}", dam);
-            }                
+            const auto modifiers = GetPitFighterModifiers();
+            const auto original  = dam;
+            dam *= Core::GetPitFighterRangedMult(modifiers, enemyNum);
+            RecordPitFighter(Core::TelemetryKind::kPitFighterBow, original, enemyNum, modifiers, dam);
+            dlog("return with {} enemies, dam is {}", enemyNum, dam);
             return dam;
         }
         dlog("return without modifying");
@@ -153,6 +164,13 @@ namespace Hooks
 
     void AdjustActiveEffect::AdjustSpells(RE::ActiveEffect* a_this, float a_power, bool a_onlyHostile)
     {
+        AdjustMagnitude(a_this);
+        func(a_this, a_power, a_onlyHostile);
+    }
+
+    void AdjustActiveEffect::AdjustMagnitude(RE::ActiveEffect* a_this)
+    {
+        HookProfiler::Scope profile(HookProfiler::Probe::kCheckAddEffect);
         const auto attacker = a_this->GetCasterActor();
         const auto target = a_this->GetTargetActor();
         const auto effect = a_this->GetBaseObject();
@@ -161,24 +179,15 @@ namespace Hooks
         if (attacker && attacker->HasPerk(settings->PitFighterPerk) && target && spell && effect && effect->IsHostile()) {
             if (const auto projectile = effect->data.projectileBase; projectile) {
                 auto dam = a_this->magnitude;
-                std::int32_t enemyNum = Conditions::NumNearbyActors(attacker.get(), 500.0f, false);
+                std::int32_t enemyNum = Conditions::NumNearbyActors(attacker.get(), pitFighterRadius, false);
                 dlog("sanity check, enemy number is {}", enemyNum);
-                if (enemyNum >= 4) {                
-                    dam *= Settings::dmgModifierMinEnemy;
-                    dlog("return with more than 4 enemies, dam is {}", dam);
-                }                
-                if (enemyNum == 3){
-                    dam *= Settings::dmgModifierMidEnemy;
-                    dlog("return with 3 enemies, dam is {}", dam);
-                }                
-                if (enemyNum <= 2 ) {
-                    dam *= Settings::dmgModifierMaxEnemy;
-                    dlog("return with 2 or less enemies, dam is {}", dam);
-                }
+                const auto modifiers = GetPitFighterModifiers();
+                dam *= Core::GetPitFighterRangedMult(modifiers, enemyNum);
+                RecordPitFighter(Core::TelemetryKind::kPitFighterSpell, a_this->magnitude, enemyNum, modifiers, dam);
+                dlog("return with {} enemies, dam is {}", enemyNum, dam);
                 a_this->magnitude = dam;
             }
         }
-        func(a_this, a_power, a_onlyHostile);
     }
     void AdjustActiveEffect::Install()
     {
@@ -54,6 +54,7 @@ namespace Hooks
 
     private:
         static void AdjustSpells(RE::ActiveEffect* a_this, float a_power, bool a_onlyHostile);
+        static void AdjustMagnitude(RE::ActiveEffect* a_this);
         static inline REL::Relocation<decltype(&AdjustSpells)> func;
     };
 
@@ -6,7 +6,7 @@ namespace
     {
     public:
         explicit HotkeyContext(const Settings* settings)
-            : hotkeyDual(settings->DualBlockKey->value), hotkey(settings->blockKeyKeyboard), hotkeyMouse(settings->blockKeyMouse), hotkeyGamepad(settings->blockKeyGamePad)
+            : hotkeyDual(settings->DualBlockKey ? settings->DualBlockKey->value : 0xFF), hotkey(settings->blockKeyKeyboard), hotkeyMouse(settings->blockKeyMouse), hotkeyGamepad(settings->blockKeyGamePad)
         {
         }
 
@@ -35,9 +35,9 @@ namespace
                 if ((hotkeyMouse.IsActive() || hotkeyDual.IsActive() || hotkey.IsActive() || hotkeyGamepad.IsActive())
                     && !Conditions::PlayerHasActiveMagicEffect(settings->MAG_ParryWindowEffect))
                 {
-                    logger::debug("block key was pressed");
+                    dlog("block key was pressed");
                     Conditions::ApplySpell(player, player, settings->MAGParryControllerSpell);
-                    logger::debug("PARRY SPELL APPLIED");
+                    dlog("PARRY SPELL APPLIED");
                     done = true;
                 }
                 if (done) {
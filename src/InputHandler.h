@@ -2,6 +2,7 @@
 #include "CLib/Key.h"
 #include "Cache.h"
 #include "Conditions.h"
+#include "HookProfiler.h"
 #include "Settings.h"
 
 #define continueEvent RE::BSEventNotifyControl::kContinue
@@ -60,21 +61,21 @@ namespace Input
                 switch (i) {
                 case RE::INPUT_DEVICE::kKeyboard:
                     blockKey[i] = cm->GetMappedKey(userEvent->leftAttack, RE::INPUT_DEVICE::kKeyboard);
-                    logger::debug("____GET MAPPED KEY____ KeyCode for keyboard block is {}", blockKey[i]);
+                    dlog("____GET MAPPED KEY____ KeyCode for keyboard block is {}", blockKey[i]);
                     settings->blockKeyKeyboard = blockKey[RE::INPUT_DEVICE::kKeyboard];
-                    logger::debug("____GET MAPPED KEY____ KeyCode for chached keyboard block is {}", settings->blockKeyKeyboard);
+                    dlog("____GET MAPPED KEY____ KeyCode for chached keyboard block is {}", settings->blockKeyKeyboard);
                     break;
                 case RE::INPUT_DEVICE::kMouse:
                     blockKey[i] = SKSE::InputMap::kMacro_MouseButtonOffset + cm->GetMappedKey(userEvent->leftAttack, RE::INPUT_DEVICE::kMouse);
-                    logger::debug("____GET MAPPED KEY____ KeyCode for mouse block is {}", blockKey[i]);
+                    dlog("____GET MAPPED KEY____ KeyCode for mouse block is {}", blockKey[i]);
                     settings->blockKeyMouse = blockKey[RE::INPUT_DEVICE::kMouse];
-                    logger::debug("____GET MAPPED KEY____ KeyCode for chached keyboard block is {}", settings->blockKeyMouse);
+                    dlog("____GET MAPPED KEY____ KeyCode for chached keyboard block is {}", settings->blockKeyMouse);
                     break;
                 case RE::INPUT_DEVICE::kGamepad:
                     blockKey[i] = SKSE::InputMap::GamepadMaskToKeycode(cm->GetMappedKey(userEvent->leftAttack, RE::INPUT_DEVICE::kGamepad));
-                    logger::debug("____GET MAPPED KEY____ KeyCode for Gamepad block is {}", blockKey[i]);
+                    dlog("____GET MAPPED KEY____ KeyCode for Gamepad block is {}", blockKey[i]);
                     settings->blockKeyGamePad = blockKey[RE::INPUT_DEVICE::kGamepad];
-                    logger::debug("____GET MAPPED KEY____ KeyCode for chached keyboard block is {}", settings->blockKeyGamePad);
+                    dlog("____GET MAPPED KEY____ KeyCode for chached keyboard block is {}", settings->blockKeyGamePad);
                     break;
                 }
             }
@@ -87,7 +88,7 @@ namespace Input
             if (compare_key == blockKey[device]) {
                 return true;
             }
-            else if (compare_key == settings->DualBlockKey->value) {
+            else if (settings->DualBlockKey && compare_key == settings->DualBlockKey->value) {
                 return true;
             }
             else {
@@ -103,6 +104,7 @@ namespace Input
                 return RE::BSEventNotifyControl::kContinue;
             }
 
+            HookProfiler::Scope profile(HookProfiler::Probe::kInput);
             Input::HotkeyManager::Process(a_event);
 
             return RE::BSEventNotifyControl::kContinue;
@@ -0,0 +1,52 @@
+#pragma once
+#include "Core/CommitQueue.h"
+#include "Core/WorkerPool.h"
+#include "HookProfiler.h"
+
+// Off-frame computation for the plugin. Run() computes on the worker pool and hands the typed
+// result to a commit function that runs on the main thread, Commit() only defers to the main
+// thread. Commits are applied by Drain() from the frame hook, before the plugin's own frame work,
+// instead of each going through its own SKSE task. The JobCompute probe of the hook profiler times
+// every computation on the workers, the JobCommit probe every drain.
+namespace Jobs
+{
+    using Task = std::function<void()>;
+
+    // Leaked on purpose, joining threads from a DLL's static destructors can deadlock on game exit
+    inline Core::WorkerPool& Pool()
+    {
+        static auto pool = new Core::WorkerPool(std::clamp(std::thread::hardware_concurrency() / 4u, 1u, 4u));
+        return *pool;
+    }
+
+    inline Core::CommitQueue<Task> commits;
+
+    // a_commit runs on the main thread at the start of the next frame
+    inline void Commit(Task a_commit)
+    {
+        commits.Push(std::move(a_commit));
+    }
+
+    // a_compute() runs on a worker and must not touch engine state, a_commit(result) runs on the
+    // main thread at the start of the first frame after it finished
+    template <typename Compute, typename Apply>
+    void Run(Compute&& a_compute, Apply&& a_commit)
+    {
+        Pool().Submit([compute = std::forward<Compute>(a_compute), apply = std::forward<Apply>(a_commit)]() mutable {
+            const auto start  = Core::ReadCycles();
+            auto       result = compute();
+            HookProfiler::Record(HookProfiler::Probe::kJobCompute, Core::ReadCycles() - start);
+            Commit([apply = std::move(apply), result = std::move(result)]() mutable { apply(std::move(result)); });
+        });
+    }
+
+    // Called from the frame hook on the main thread
+    inline void Drain()
+    {
+        if (commits.Empty()) {
+            return;
+        }
+        HookProfiler::Scope profile(HookProfiler::Probe::kJobCommit);
+        commits.Drain([](Task& a_commit) { a_commit(); });
+    }
+} // namespace Jobs
@@ -0,0 +1,140 @@
+#pragma once
+#include "ActorSpatialIndex.h"
+#include "Conditions.h"
+#include "Core/ParryTargets.h"
+#include "HookProfiler.h"
+#include "TelemetryRecorder.h"
+
+// Resolves player parries (weapon and shield) for the hit event handler.
+// The attacker is staggered and the parry buff applied inside the hit event as before, the
+// surrounding actors are gathered from the spatial index, filtered (living, hostile to the player
+// with bParryHostileOnly, inside fParryConeDegrees around the player's facing), capped to the
+// nearest iParryMaxTargets and staggered by the frame hook at most iParryStaggersPerFrame casts per
+// frame, so a parry in a crowd no longer fires every immediate cast in one callback.
+// The time from the parry to its last stagger lands in the ParryLatency row of the hook profiler.
+class ParryResolver
+{
+public:
+    static ParryResolver* GetSingleton()
+    {
+        static ParryResolver singleton;
+        return &singleton;
+    }
+
+    void Resolve(RE::Actor* a_defender, RE::Actor* a_aggressor, bool a_shield)
+    {
+        const auto settings = Settings::GetSingleton();
+        if (!Conditions::PlayerHasActiveMagicEffect(settings->MAG_ParryWindowEffect)) {
+            return;
+        }
+        const auto& config = Settings::Values();
+
+        Conditions::ApplySpell(a_defender, a_aggressor, settings->MAGParryStaggerSpell);
+        Conditions::ApplySpell(a_aggressor, a_defender, settings->APOParryBuffSPell);
+        a_defender->PlaceObjectAtMe(a_shield ? settings->APOSparksShieldFlash : settings->APOSparksFlash, false);
+
+        std::lock_guard lock(mutex);
+        actors.clear();
+        candidates.clear();
+
+        const auto origin = a_defender->GetPosition();
+        ActorSpatialIndex::GetSingleton()->ForEachNearby(a_defender, config.surroundingActorsRange, false, [&](RE::Actor* a_actor) {
+            if (a_actor == a_aggressor) {
+                return;
+            }
+            const auto pos = a_actor->GetPosition();
+            actors.push_back(a_actor);
+            candidates.push_back({ pos.x - origin.x, pos.y - origin.y, a_actor->IsHostileToActor(a_defender), a_actor->IsDead() });
+        });
+
+        const auto passed = Core::SelectParryTargets(candidates, a_defender->GetAngleZ(),
+                                                     { config.parryConeDegrees, config.parryMaxTargets, config.parryHostileOnly }, selected);
+
+        Parry parry;
+        parry.id        = ++lastId;
+        parry.started   = Core::ReadCycles();
+        parry.remaining = static_cast<std::uint32_t>(selected.size());
+        for (const auto index : selected) {
+            pending.push_back({ a_defender->GetHandle(), actors[index]->GetHandle(), parry.id });
+        }
+
+        dlog("[parry] #{}: {} nearby, {} pass the filters, staggering {}", parry.id, candidates.size(), passed, selected.size());
+        TelemetryRecorder::GetSingleton()->Record(Core::TelemetryKind::kParry, a_shield, { static_cast<float>(selected.size() + 1) }, 0.0f);
+        if (parry.remaining) {
+            parries.push_back(parry);
+        }
+        else {
+            Finish(parry);
+        }
+    }
+
+    // Called from the frame hook on the main thread
+    void Update(std::uint32_t a_staggersPerFrame)
+    {
+        std::lock_guard lock(mutex);
+        if (pending.empty()) {
+            return;
+        }
+
+        const auto stagger = Settings::GetSingleton()->MAGParryStaggerSpell;
+        auto       budget  = a_staggersPerFrame ? a_staggersPerFrame : std::numeric_limits<std::uint32_t>::max();
+        for (; !pending.empty() && budget; --budget) {
+            const auto cast = pending.front();
+            pending.pop_front();
+
+            const auto caster = cast.caster.get();
+            const auto target = cast.target.get();
+            if (caster && target && !target->IsDead()) {
+                Conditions::ApplySpell(caster.get(), target.get(), stagger);
+            }
+
+            const auto parry = std::ranges::find(parries, cast.parry, &Parry::id);
+            if (parry != parries.end() && --parry->remaining == 0) {
+                Finish(*parry);
+                parries.erase(parry);
+            }
+        }
+        for (auto& parry : parries) {
+            parry.frames++;
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard lock(mutex);
+        pending.clear();
+        parries.clear();
+    }
+
+private:
+    struct Cast
+    {
+        RE::ActorHandle caster;
+        RE::ActorHandle target;
+        std::uint32_t   parry;
+    };
+
+    struct Parry
+    {
+        std::uint32_t id{ 0 };
+        std::uint64_t started{ 0 };
+        std::uint32_t remaining{ 0 };
+        std::uint32_t frames{ 0 };
+    };
+
+    ParryResolver() = default;
+
+    static void Finish(const Parry& a_parry)
+    {
+        HookProfiler::Record(HookProfiler::Probe::kParryLatency, Core::ReadCycles() - a_parry.started);
+        dlog("[parry] #{} resolved after {} frames", a_parry.id, a_parry.frames);
+    }
+
+    std::mutex                        mutex;
+    std::deque<Cast>                  pending;
+    std::vector<Parry>                parries;
+    std::uint32_t                     lastId{ 0 };
+    std::vector<RE::Actor*>           actors;
+    std::vector<Core::ParryCandidate> candidates;
+    std::vector<std::uint32_t>        selected;
+};
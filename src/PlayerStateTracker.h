@@ -0,0 +1,123 @@
+#pragma once
+#include "AnimationTagDispatcher.h"
+#include "Core/StateTracker.h"
+
+// Feeds animation graph events, action events and actor state transitions of the player into a
+// Core::StateTracker so that UpdateManager only re-evaluates a state spell when something could
+// have changed it. Movement (sneak, sprint) has no reliable graph event, so the two packed
+// ActorState words are compared once per frame instead, which is a pair of integer compares.
+class PlayerStateTracker :
+    public EventSingleton<PlayerStateTracker, SKSE::ActionEvent>
+{
+public:
+    enum State : std::uint32_t
+    {
+        kCasting,
+        kBowDraw,
+        kXbowDraw,
+        kAttackBlock,
+        kSneaking,
+        kSprinting,
+
+        kTotal
+    };
+
+    using Tracker = Core::StateTracker<kTotal>;
+    using Mask    = Tracker::Mask;
+
+    static constexpr Mask Bit(State a_state) noexcept { return Tracker::Bit(a_state); }
+
+    void MarkDirty(Mask a_states) noexcept { tracker.MarkDirty(a_states); }
+    void MarkAllDirty() noexcept { tracker.MarkAllDirty(); }
+
+    Mask Consume(std::uint32_t a_reconcileInterval) noexcept { return tracker.Consume(a_reconcileInterval); }
+
+    // Called once per frame, marks the states that depend on the actor state flags when they changed
+    void OnActorState(RE::ActorState* a_state) noexcept
+    {
+        const auto state1 = std::bit_cast<std::uint32_t>(a_state->actorState1);
+        const auto state2 = std::bit_cast<std::uint32_t>(a_state->actorState2);
+
+        if (state1 != lastState1) {
+            tracker.MarkDirty(Bit(kBowDraw) | Bit(kXbowDraw) | Bit(kAttackBlock) | Bit(kSneaking) | Bit(kSprinting));
+        }
+        if (state2 != lastState2) {
+            tracker.MarkDirty(Bit(kBowDraw) | Bit(kXbowDraw) | Bit(kAttackBlock));
+        }
+        lastState1 = state1;
+        lastState2 = state2;
+    }
+
+    // Hooks the player's graph tags that can change a tracked state into the tag dispatcher
+    void RegisterTags(AnimationTagDispatcher* a_dispatcher)
+    {
+        for (const auto& [tag, states] : tagStates) {
+            a_dispatcher->Register(tag, [this, states](RE::Actor* a_actor, const RE::BSAnimationGraphEvent&) {
+                if (a_actor->IsPlayerRef()) {
+                    tracker.MarkDirty(states);
+                }
+            });
+        }
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const SKSE::ActionEvent* a_event, RE::BSTEventSource<SKSE::ActionEvent>*) override
+    {
+        if (!a_event || !a_event->actor || !a_event->actor->IsPlayerRef()) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        using Type = SKSE::ActionEvent::Type;
+        switch (*a_event->type) {
+        case Type::kSpellCast:
+        case Type::kSpellFire:
+        case Type::kVoiceCast:
+        case Type::kVoiceFire:
+            tracker.MarkDirty(Bit(kCasting));
+            break;
+        case Type::kBowDraw:
+        case Type::kBowRelease:
+            tracker.MarkDirty(Bit(kBowDraw) | Bit(kXbowDraw) | Bit(kAttackBlock));
+            break;
+        case Type::kWeaponSwing:
+            tracker.MarkDirty(Bit(kAttackBlock));
+            break;
+        default:
+            // draw, sheathe and anything new can change every state
+            tracker.MarkAllDirty();
+            break;
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+private:
+    Tracker       tracker;
+    std::uint32_t lastState1{ 0 };
+    std::uint32_t lastState2{ 0 };
+
+    // clang-format off
+    inline static const std::pair<std::string_view, Mask> tagStates[]{
+        { "BeginCastLeft",         Bit(kCasting) },
+        { "BeginCastRight",        Bit(kCasting) },
+        { "BeginCastVoice",        Bit(kCasting) },
+        { "CastStop",              Bit(kCasting) },
+        { "MLh_SpellFire_Event",   Bit(kCasting) },
+        { "MRh_SpellFire_Event",   Bit(kCasting) },
+        { "bowDraw",               Bit(kBowDraw) | Bit(kXbowDraw) },
+        { "bowDrawStart",          Bit(kBowDraw) | Bit(kXbowDraw) },
+        { "BowDrawn",              Bit(kBowDraw) | Bit(kXbowDraw) },
+        { "arrowAttach",           Bit(kBowDraw) },
+        { "BowRelease",            Bit(kBowDraw) | Bit(kXbowDraw) | Bit(kAttackBlock) },
+        { "reloadStart",           Bit(kXbowDraw) },
+        { "reloadStop",            Bit(kXbowDraw) },
+        { "BowZoomStart",          Bit(kBowDraw) | Bit(kXbowDraw) },
+        { "BowZoomStop",           Bit(kBowDraw) | Bit(kXbowDraw) },
+        { "weaponSwing",           Bit(kAttackBlock) },
+        { "weaponLeftSwing",       Bit(kAttackBlock) },
+        { "PowerAttack_Start_end", Bit(kAttackBlock) },
+        { "attackStop",            Bit(kAttackBlock) | Bit(kBowDraw) | Bit(kXbowDraw) },
+        { "blockStartOut",         Bit(kAttackBlock) },
+        { "blockStop",             Bit(kAttackBlock) },
+        { "bashStop",              Bit(kAttackBlock) },
+    };
+    // clang-format on
+};
@@ -1,7 +1,15 @@
 #include "Settings.h"
 #include "Cache.h"
 #include "Conditions.h"
+#include "Core/Random.h"
+#include "Core/RecordPatcher.h"
+#include "FormManifest.h"
+#include "GameSettings.h"
+#include "HookProfiler.h"
+#include "Jobs.h"
+#include "TelemetryRecorder.h"
 #include <SimpleIni.h>
+#include <filesystem>
 #include <sstream>
 
 Settings* Settings::GetSingleton()
@@ -10,46 +18,118 @@ Settings* Settings::GetSingleton()
     return &settings;
 }
 
-void Settings::LoadSettings()
+namespace
 {
-    logger::info("loading settings...");
-    CSimpleIniA ini;
-    ini.SetUnicode();
-    ini.LoadFile(R"(.\Data\SKSE\Plugins\paragon-perks.ini)");
+    constexpr auto settingsPath = R"(.\Data\SKSE\Plugins\paragon-perks.ini)";
 
-    enableSneakStaminaCost = ini.GetBoolValue("", "bEnableSneakStaminaCost", true);
-    zeroAllWeapStagger     = ini.GetBoolValue("", "bZeroAllWeaponStagger", true);
-    armorScalingEnabled    = ini.GetBoolValue("", "bArmorRatingScalingEnabled", true);
-    debug_logging          = ini.GetBoolValue("", "Debug");
+    std::filesystem::file_time_type WriteTime()
+    {
+        std::error_code ec;
+        return std::filesystem::last_write_time(settingsPath, ec);
+    }
+} // namespace
 
-    surroundingActorsRange = (float)ini.GetDoubleValue("", "fRangeActors", 16.0);
-    auto bonusXP           = (float)ini.GetDoubleValue("", "fBonusXPPerLevel", 0.15);
-    auto baseXP            = (float)ini.GetDoubleValue("", "fBaseXPHerHit", 3.0);
+void Settings::LoadSettings()
+{
+    logger::info("loading settings...");
+    Publish(ParseConfig());
 
-    (bonusXP < 0.0 || bonusXP > 100.0) ? BonusXPPerLevel = 0.15f : BonusXPPerLevel = bonusXP;
-    baseXP < 0.0 ? BaseXP = 3.0f : BaseXP = baseXP;
+    // the trace file is sized once, a changed record count takes effect on the next game start
+    TelemetryRecorder::GetSingleton()->Open(Values().telemetryRecords);
 
     FileName = "ValorPerks.esp";
-
-    if (debug_logging) {
-        spdlog::get("Global")->set_level(spdlog::level::level_enum::debug);
-        logger::debug("Debug logging enabled");
-    };
     logger::info("... finished");
 }
 
-void Settings::LoadMCMSettings()
+std::unique_ptr<const Settings::Config> Settings::ParseConfig() const
 {
-    logger::info("loading MCM settings...");
+    auto config = std::make_unique<Config>();
+
     CSimpleIniA ini;
     ini.SetUnicode();
-    ini.LoadFile(L"(.\"Data\MCM\Config\ValorPerks\settings.ini");
+    ini.LoadFile(settingsPath);
+
+    config->enableSneakStaminaCost = ini.GetBoolValue("", "bEnableSneakStaminaCost", true);
+    config->zeroAllWeapStagger     = ini.GetBoolValue("", "bZeroAllWeaponStagger", true);
+    config->armorScalingEnabled    = ini.GetBoolValue("", "bArmorRatingScalingEnabled", true);
+    config->debugLogging           = ini.GetBoolValue("", "Debug");
+
+    config->surroundingActorsRange = (float)ini.GetDoubleValue("", "fRangeActors", 16.0);
+    config->stateReconcileFrames   = (std::uint32_t)ini.GetLongValue("", "iStateReconcileFrames", 30);
+    config->hitDedupWindowMs       = (std::int32_t)ini.GetLongValue("", "iHitDedupWindowMs", -1);
+    config->volleyShotsPerFrame    = (std::uint32_t)ini.GetLongValue("", "iVolleyShotsPerFrame", 15);
+    config->randomSeed             = (std::uint64_t)ini.GetLongValue("", "iRandomSeed", 0);
+    config->profileHooks           = ini.GetBoolValue("", "bProfileHooks", false);
+    config->profileDumpSeconds     = (std::uint32_t)ini.GetLongValue("", "iProfileDumpSeconds", 10);
+    config->telemetryRecords       = (std::uint32_t)std::max(ini.GetLongValue("", "iTelemetryRecords", 0), 0L);
+    config->parryMaxTargets        = (std::uint32_t)std::max(ini.GetLongValue("", "iParryMaxTargets", 8), 0L);
+    config->parryConeDegrees       = std::clamp((float)ini.GetDoubleValue("", "fParryConeDegrees", 360.0), 0.0f, 360.0f);
+    config->parryHostileOnly       = ini.GetBoolValue("", "bParryHostileOnly", true);
+    config->parryStaggersPerFrame  = (std::uint32_t)std::max(ini.GetLongValue("", "iParryStaggersPerFrame", 2), 0L);
+    config->actorUpdateNearRadius  = (float)ini.GetDoubleValue("", "fActorUpdateNearRadius", 1500.0);
+    config->actorUpdateFarRadius   = std::max((float)ini.GetDoubleValue("", "fActorUpdateFarRadius", 4096.0), config->actorUpdateNearRadius);
+    config->actorUpdateMidInterval = (std::uint32_t)std::max(ini.GetLongValue("", "iActorUpdateMidInterval", 4), 1L);
+    auto bonusXP                   = (float)ini.GetDoubleValue("", "fBonusXPPerLevel", 0.15);
+    auto armorCurve                = ini.GetValue("", "sArmorCurve", nullptr);
+    auto baseXP                    = (float)ini.GetDoubleValue("", "fBaseXPHerHit", 3.0);
+
+    config->bonusXPPerLevel = (bonusXP < 0.0 || bonusXP > 100.0) ? 0.15f : bonusXP;
+    config->baseXP          = baseXP < 0.0 ? 3.0f : baseXP;
+
+    std::vector<Core::ArmorCurvePoint> armorCurvePoints;
+    if (armorCurve && Core::ArmorCurve::Parse(armorCurve, armorCurvePoints)) {
+        config->armorCurve = Core::ArmorCurve::Compile(armorCurvePoints);
+    }
+    else if (armorCurve) {
+        logger::warn("sArmorCurve \"{}\" is not a list of rating:resist points, keeping the default curve", armorCurve);
+    }
 
+    return config;
+}
 
-    ReadColorStringSetting(ini, "General", "colorCodeStaminaPenalty", uColorCodeStamBar);
-    dualBlockKey = std::stoi(ini.GetValue("General", "iDualBlockKey", "48"));
+void Settings::Publish(std::unique_ptr<const Config> a_config)
+{
+    const auto& next     = *a_config;
+    const auto& previous = config.Publish(std::move(a_config));
+
+    // fixed seed only for replaying recorded sessions, 0 seeds every thread randomly
+    if (previous.randomSeed != next.randomSeed) {
+        Core::SetRandomSeed(next.randomSeed);
+    }
 
+    HookProfiler::Enable(next.profileHooks);
 
+    spdlog::get("Global")->set_level(next.debugLogging ? spdlog::level::level_enum::debug : spdlog::level::level_enum::info);
+    dlog("Debug logging enabled");
+}
+
+// Reparses the ini file off the main thread when it is written to, readers pick the new Config
+// up on their next Values() call. Every published Config is kept alive for good, so a save that
+// changes no value publishes nothing. Detached on purpose, joining a thread from a DLL's static
+// destructors can deadlock on game exit.
+void Settings::StartReloadThread()
+{
+    std::thread([this] {
+        auto stamp = WriteTime();
+        for (;;) {
+            std::this_thread::sleep_for(2s);
+
+            const auto now = WriteTime();
+            if (now == stamp) {
+                continue;
+            }
+            stamp = now;
+
+            const auto start = std::chrono::steady_clock::now();
+            auto       next  = ParseConfig();
+            if (*next == Values()) {
+                dlog("settings file written, no value changed");
+                continue;
+            }
+            Publish(std::move(next));
+            logger::info("settings reloaded in {:.3f} ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+    }).detach();
 }
 
 RE::FormID Settings::ParseFormID(const std::string& str)
@@ -62,148 +142,118 @@ RE::FormID Settings::ParseFormID(const std::string& str)
 
 void Settings::AdjustWeaponStaggerVals()
 {
-    if (zeroAllWeapStagger) {
-        logger::info("Adjusting weapon stagger values");
-        int16_t totalWeaps = 0;
-
-        auto dataHandler = RE::TESDataHandler::GetSingleton();
-        if (dataHandler) {
-            for (const auto& foundWeap : dataHandler->GetFormArray<RE::TESObjectWEAP>()) {
-                if (foundWeap && !foundWeap->weaponData.flags.any(RE::TESObjectWEAP::Data::Flag::kNonPlayable)) {
-                    foundWeap->weaponData.staggerValue = 0.0f;
-                    totalWeaps++;
-                }
-            }
-        }
+    // load time weapon record rewrites, each rule only touches the record it is handed
+    std::vector<Core::PatchRule<RE::TESObjectWEAP>> rules;
+    if (Values().zeroAllWeapStagger) {
+        rules.push_back({ "zero stagger", [](RE::TESObjectWEAP& a_weapon) {
+                             if (a_weapon.weaponData.flags.any(RE::TESObjectWEAP::Data::Flag::kNonPlayable)) {
+                                 return false;
+                             }
+                             a_weapon.weaponData.staggerValue = 0.0f;
+                             return true;
+                         } });
+    }
 
-        logger::info(FMT_STRING("Stagger values adjusted: {} weapons"), totalWeaps);
+    auto dataHandler = RE::TESDataHandler::GetSingleton();
+    if (rules.empty() || !dataHandler) {
+        return;
+    }
+
+    logger::info("Patching weapon records");
+    auto&      weapons = dataHandler->GetFormArray<RE::TESObjectWEAP>();
+    const auto report  = Core::PatchRecords<RE::TESObjectWEAP>(std::span<RE::TESObjectWEAP* const>(weapons.data(), weapons.size()), rules, &Jobs::Pool());
+    for (const auto& rule : report.rules) {
+        logger::info(FMT_STRING("{}: {} weapons adjusted ({:.3f} ms)"), rule.name, rule.patched, rule.ms);
     }
+    logger::info(FMT_STRING("{} weapon records patched in {:.3f} ms on {} threads"), report.records, report.wallMs, report.workers);
 }
 
-void Settings::GetIngameData() // hard coded FormIDs to keep the ini file simpler for users
+bool Settings::GetIngameData() // FormIDs are compiled in to keep the ini file simpler for users, [Forms] can still override them
 {
-    /*CSimpleIniA ini;
-    ini.SetUnicode();
-    ini.LoadFile(R"(.\Data\SKSE\Plugins\paragon-form-lookup.ini)");*/
-
-
-    //forms for ini:
-    const int stam_cost_global = 0x25C;
-    const int npc_stam_cost = 0x25D;
-    const int dual_block_key = 0x2BD;
-    const int bashStamPerk = 0xADA510;
-    const int blockStamPerk = 0xADA509;
-    const int DodgePerk = 0x2E9;
-    const int ParryWindowEffect = 0xD9E;
-    const int isBlockSpell = 0xDAC;
-    const int power_attack_stop= 0x228;
-    const int jump_spell = 0x225;
-    const int isAttackSpel = 0xDA9;
-    const int isSneakSpel= 0xDB4;
-    const int sprint_spel = 0xDB6;
-    const int mount_sprint = 0xDB1;
-    const int bow_stam_spel = 0xDAE;
-    const int x_bow_stam_spel = 0xDB0;
-    const int casting_spel = 0xDB5;
-    const int parry_control_spel = 0xDB2;
-    const int parry_stagger_spel = 0xDB3;
-    const int parry_buff_spel= 0xAE;
-    const int crossbow_stam_drain = 0xDAF ;
-    const int dodge_spell = 0x2C8;
-    const int shield_sparks= 0xAC;
-    const int weapon_sparks= 0xAB;
-    const int physic_sparks= 0xA9;
-    const int normal_sparks= 0xAA;
-
-    const int multi_shot_perk = 0x0;
-    const int multi_shot_cd_spell = 0x0;
-    const int multi_shot_cd_effect = 0x0;
-    const int arrow_rain_perk = 0x0;
-    const int arrow_rain_cd_spell = 0x0;
-    const int arrow_rain_cd_effect = 0x0; 
-    const int stam_pen_effect = 0x06D;
-    const int npc_stam_pen_effect = 0xCD8;
-    const int pit_fighter_perk = 0xC5;
-
-    auto dataHandler = RE::TESDataHandler::GetSingleton();
+    using FormManifest::Bind;
+    const std::string_view update = "Update.esm";
+
+    // clang-format off
+    std::vector<FormManifest::Entry> manifest{
+        // Globals
+        Bind("StaminaCostGlobal",            FileName, 0x25C,    StaminaCostGlobal),
+        Bind("NPCStaminaCostGlobal",         FileName, 0x25D,    NPCStaminaCostGlobal),
+        Bind("DualBlockKey",                 FileName, 0x2BD,    DualBlockKey),
+        // Perks
+        Bind("BashStaminaPerk",              update,   0xADA510, BashStaminaPerk),
+        Bind("BlockStaminaPerk",             update,   0xADA509, BlockStaminaPerk),
+        Bind("PitFighterPerk",               FileName, 0xC5,     PitFighterPerk),
+        Bind("DodgePerk",                    FileName, 0x2E9,    dummyPerkDodge),
+        //Bind("ArrowRainPerk",              FileName, 0x0,      ArrowRainPerk),
+        //Bind("MultiShotPerk",              FileName, 0x0,      MultiShotPerk),
+        // Effects
+        Bind("ParryWindowEffect",            FileName, 0xD9E,    MAG_ParryWindowEffect),
+        Bind("StaminaPenaltyEffect",         FileName, 0x06D,    StaminaPenaltyEffect),
+        Bind("NPCStaminaPenaltyEffect",      FileName, 0xCD8,    StaminaPenEffectNPC),
+        //Bind("ArrowRainCooldownEffect",    FileName, 0x0,      ArrowRainCooldownEffect),
+        //Bind("MultiShotCooldownEffect",    FileName, 0x0,      MultiShotCooldownEffect),
+        // Spells
+        Bind("IsBlockingSpell",              FileName, 0xDAC,    IsBlockingSpell),
+        Bind("PowerAttackStopSpell",         FileName, 0x228,    PowerAttackStopSpell),
+        Bind("JumpSpell",                    FileName, 0x225,    jumpSpell),
+        Bind("IsAttackingSpell",             FileName, 0xDA9,    IsAttackingSpell),
+        Bind("IsSneakingSpell",              FileName, 0xDB4,    IsSneakingSpell),
+        Bind("IsSprintingSpell",             FileName, 0xDB6,    IsSprintingSpell),
+        Bind("MountSprintingSpell",          FileName, 0xDB1,    MountSprintingSpell),
+        Bind("BowStaminaSpell",              FileName, 0xDAE,    BowStaminaSpell),
+        Bind("XbowStaminaSpell",             FileName, 0xDB0,    XbowStaminaSpell),
+        Bind("IsCastingSpell",               FileName, 0xDB5,    IsCastingSpell),
+        Bind("ParryControllerSpell",         FileName, 0xDB2,    MAGParryControllerSpell),
+        Bind("ParryStaggerSpell",            FileName, 0xDB3,    MAGParryStaggerSpell),
+        Bind("ParryBuffSpell",               FileName, 0xAE,     APOParryBuffSPell),
+        Bind("CrossbowStaminaDrainSpell",    FileName, 0xDAF,    MAGCrossbowStaminaDrainSpell),
+        Bind("DodgeRuneSpell",               FileName, 0x2C8,    DodgeRuneSpell),
+        //Bind("ArrowRainCooldownSpell",     FileName, 0x0,      ArrowRainCooldownSpell),
+        //Bind("MultiShotCooldownSpell",     FileName, 0x0,      MultiShotCooldownSpell),
+        // Explosions
+        Bind("SparksShieldFlash",            FileName, 0xAC,     APOSparksShieldFlash),
+        Bind("SparksFlash",                  FileName, 0xAB,     APOSparksFlash),
+        Bind("SparksPhysics",                FileName, 0xA9,     APOSparksPhysics),
+        Bind("Sparks",                       FileName, 0xAA,     APOSparks),
+        // test stuff
+        Bind("FireBolt",                     "Skyrim.esm", 0x2DD29, fireBolt, false),
+    };
+    // clang-format on
 
-    //ArrowRainPerk = dataHandler->LookupForm(arrow_rain_perk, FileName)->As<RE::BGSPerk>();
-    //ArrowRainCooldownSpell = dataHandler->LookupForm(arrow_rain_cd_spell, FileName)->As<RE::SpellItem>();
-    //ArrowRainCooldownEffect = dataHandler->LookupForm(arrow_rain_cd_effect, FileName)->As<RE::EffectSetting>();
-
-    //MultiShotPerk = dataHandler->LookupForm(multi_shot_perk, FileName)->As<RE::BGSPerk>();
-    //MultiShotCooldownSpell = dataHandler->LookupForm(multi_shot_cd_spell, FileName)->As<RE::SpellItem>();
-    //MultiShotCooldownEffect = dataHandler->LookupForm(multi_shot_cd_effect, FileName)->As<RE::EffectSetting>();
-
-    // Globals:
-    StaminaCostGlobal    = dataHandler->LookupForm(stam_cost_global, FileName)->As<RE::TESGlobal>();
-    NPCStaminaCostGlobal = dataHandler->LookupForm(npc_stam_cost, FileName)->As<RE::TESGlobal>();
-    DualBlockKey         = dataHandler->LookupForm(dual_block_key, FileName)->As<RE::TESGlobal>();
-    // Perks:
-    BashStaminaPerk  = dataHandler->LookupForm(bashStamPerk, "Update.esm")->As<RE::BGSPerk>();
-    BlockStaminaPerk = dataHandler->LookupForm(blockStamPerk, "Update.esm")->As<RE::BGSPerk>();
-    PitFighterPerk = dataHandler->LookupForm(pit_fighter_perk, FileName)->As<RE::BGSPerk>();
-    dummyPerkDodge = dataHandler->LookupForm(DodgePerk, FileName)->As<RE::BGSPerk>();
-    // Effects:
-    MAG_ParryWindowEffect = dataHandler->LookupForm(ParryWindowEffect, FileName)->As<RE::EffectSetting>();
-    StaminaPenaltyEffect = dataHandler->LookupForm(stam_pen_effect, FileName)->As<RE::EffectSetting>();
-    StaminaPenEffectNPC = dataHandler->LookupForm(npc_stam_pen_effect, FileName)->As<RE::EffectSetting>();
-    // Spells:
-    IsBlockingSpell              = dataHandler->LookupForm(isBlockSpell, FileName)->As<RE::SpellItem>();
-    PowerAttackStopSpell         = dataHandler->LookupForm(power_attack_stop, FileName)->As<RE::SpellItem>();
-    jumpSpell                    = dataHandler->LookupForm(jump_spell, FileName)->As<RE::SpellItem>();
-    IsAttackingSpell             = dataHandler->LookupForm(isAttackSpel, FileName)->As<RE::SpellItem>();
-    IsSneakingSpell              = dataHandler->LookupForm(isSneakSpel, FileName)->As<RE::SpellItem>();
-    IsSprintingSpell             = dataHandler->LookupForm(sprint_spel, FileName)->As<RE::SpellItem>();
-    MountSprintingSpell          = dataHandler->LookupForm(mount_sprint, FileName)->As<RE::SpellItem>();
-    BowStaminaSpell              = dataHandler->LookupForm(bow_stam_spel, FileName)->As<RE::SpellItem>();
-    XbowStaminaSpell             = dataHandler->LookupForm(x_bow_stam_spel, FileName)->As<RE::SpellItem>();
-    IsCastingSpell               = dataHandler->LookupForm(casting_spel, FileName)->As<RE::SpellItem>();
-    MAGParryControllerSpell      = dataHandler->LookupForm(parry_control_spel, FileName)->As<RE::SpellItem>();
-    MAGParryStaggerSpell         = dataHandler->LookupForm(parry_stagger_spel, FileName)->As<RE::SpellItem>();
-    APOParryBuffSPell            = dataHandler->LookupForm(parry_buff_spel, FileName)->As<RE::SpellItem>();
-    MAGCrossbowStaminaDrainSpell = dataHandler->LookupForm(crossbow_stam_drain, FileName)->As<RE::SpellItem>();
-    DodgeRuneSpell = dataHandler->LookupForm(dodge_spell, FileName)->As<RE::SpellItem>();
-    // Explosions:
-    APOSparksShieldFlash = dataHandler->LookupForm(shield_sparks, FileName)->As<RE::BGSExplosion>();
-    APOSparksFlash       = dataHandler->LookupForm(weapon_sparks, FileName)->As<RE::BGSExplosion>();
-    APOSparksPhysics     = dataHandler->LookupForm(physic_sparks, FileName)->As<RE::BGSExplosion>();
-    APOSparks            = dataHandler->LookupForm(normal_sparks, FileName)->As<RE::BGSExplosion>();
-    
-    // test stuff
-    fireBolt = dataHandler->LookupForm(0x2dd29, "Skyrim.esm")->As<RE::SpellItem>();
-
-    logger::debug("ingame forms loaded");
+    if (!FormManifest::Resolve(manifest, R"(.\Data\SKSE\Plugins\paragon-perks.ini)")) {
+        return false;
+    }
+    dlog("ingame forms loaded");
+    return true;
 }
 
 
 
-void Settings::LoadForms()
+bool Settings::LoadForms()
 {
-    auto dataHandler = RE::TESDataHandler::GetSingleton();
-    
-    GetIngameData();
+    const auto complete = GetIngameData();
     SetGlobalsAndGameSettings();
 
-    auto gameSettings = RE::GameSettingCollection::GetSingleton();
-    blockAngleSetting = gameSettings->GetSetting("fCombatHitConeAngle")->GetFloat();
-
-    dualBlockKey = DualBlockKey->value;
+    blockAngleSetting = GameSettings::GetFloat(GameSettings::ID::kCombatHitConeAngle);
 
+    if (!complete) {
+        logger::error("Required forms are missing, is ValorPerks.esp enabled?");
+        return false;
+    }
     logger::info("All Forms loaded");
+    return true;
 }
 
 void Settings::SetGlobalsAndGameSettings()
 {
     // Set fMaxArmorRating game setting
-    auto gameSettings     = RE::GameSettingCollection::GetSingleton();    
-    auto maxRatingSetting = gameSettings->GetSetting("fMaxArmorRating");
+    auto maxRatingSetting = GameSettings::Get(GameSettings::ID::kMaxArmorRating);
 
-    if (armorScalingEnabled) {
+    if (Values().armorScalingEnabled) {
         logger::info("Setting max armor rating from {} to 90", maxRatingSetting->data.f);
         
         maxRatingSetting->data.f = 90.0f;
-        logger::debug("donezo");
+        dlog("donezo");
         return;
     }
     else {
@@ -212,47 +262,4 @@ void Settings::SetGlobalsAndGameSettings()
         return;
     } 
 }
-void Settings::ReadColorStringSetting(CSimpleIniA& a_ini, const char* a_sectionName, const char* a_settingName, uint32_t& a_setting)
-{
-    const char* value = nullptr;
-    constexpr std::string_view prefix1 = "0x";
-    constexpr std::string_view prefix2 = "#";
-    constexpr std::string_view cset = "0123456789ABCDEFabcdef";
-
-    value = a_ini.GetValue(a_sectionName, a_settingName);
-    if (value) {
-        std::string_view str = value;
-
-        if (str.starts_with(prefix1)) {
-            str.remove_prefix(prefix1.size());
-        }
-
-        if (str.starts_with(prefix2)) {
-            str.remove_prefix(prefix2.size());
-        }
-
-        bool bMatches = std::strspn(str.data(), cset.data()) == str.size();
-
-        if (bMatches) {
-            a_setting = std::stoi(str.data(), 0, 16);
-        }
-        else {
-            const auto skyrimVM = RE::SkyrimVM::GetSingleton();
-            auto vm = skyrimVM ? skyrimVM->impl : nullptr;
-            if (vm) {
-                RE::BSFixedString modName{ "ValorPerks" };
-                std::string settingStr = a_settingName;
-                settingStr.append(":");
-                settingStr.append(a_sectionName);
-                RE::BSFixedString setting = settingStr;
-                std::string settingValue = "0xFFFFFF";
-                RE::BSTSmartPointer<RE::BSScript::IStackCallbackFunctor> callback;
-                auto vmargs = RE::MakeFunctionArguments(std::move(modName), std::move(setting), std::move(settingValue));
-                vm->DispatchStaticCall("MCM", "SetModSettingString", vmargs, callback);
-                delete vmargs;
-            }
-        }
-    }
-}
-
 
@@ -1,17 +1,52 @@
 #pragma once
+#include "Core/ArmorCurve.h"
+#include "Core/Snapshot.h"
 
 class Settings
 {
 public:
+    // Values read from paragon-perks.ini. Never changed once published, a
+    // reload parses into a fresh Config and swaps it in, so a reader that took Values() once sees
+    // one consistent set for as long as it holds the reference.
+    struct Config
+    {
+        bool          enableSneakStaminaCost = true;
+        bool          zeroAllWeapStagger     = true;
+        bool          armorScalingEnabled    = true;
+        bool          debugLogging           = false;
+        float         bonusXPPerLevel        = 0.15f;
+        float         baseXP                 = 3.0f;
+        float         surroundingActorsRange = 16.0f;
+        std::uint32_t stateReconcileFrames   = 30;
+        std::int32_t  hitDedupWindowMs       = -1; // negative disables the hit event dedup
+        std::uint32_t volleyShotsPerFrame    = 15; // 0 fires a whole volley in one frame
+        std::uint64_t randomSeed             = 0;
+        bool          profileHooks           = false;
+        std::uint32_t profileDumpSeconds     = 10;
+        std::uint32_t telemetryRecords       = 0; // read once at plugin load, 0 records nothing
+        std::uint32_t parryMaxTargets        = 8;
+        float         parryConeDegrees       = 360.0f;
+        bool          parryHostileOnly       = true;
+        std::uint32_t parryStaggersPerFrame  = 2; // 0 staggers everyone in the first frame
+        float         actorUpdateNearRadius  = 1500.0f;
+        float         actorUpdateFarRadius   = 4096.0f;
+        std::uint32_t actorUpdateMidInterval = 4; // 1 updates every actor within the far radius every frame
+
+        Core::ArmorCurve armorCurve; // compiled from sArmorCurve
+
+        bool operator==(const Config&) const = default;
+    };
+
     static Settings* GetSingleton();
 
+    static const Config& Values() noexcept { return GetSingleton()->config.Get(); }
+
     void LoadSettings();
-    void LoadForms();
+    void StartReloadThread();
+    bool LoadForms(); // false when a required form is missing
     void AdjustWeaponStaggerVals();
-    void GetIngameData();
+    bool GetIngameData();
     void SetGlobalsAndGameSettings();  
-    void LoadMCMSettings();
-    void ReadColorStringSetting(CSimpleIniA& a_ini, const char* a_sectionName, const char* a_settingName, uint32_t& a_setting);
 
     // Spells
     RE::SpellItem* IsAttackingSpell;
@@ -60,27 +95,15 @@ public:
     RE::SpellItem* fireBolt;
 
     // bools
-    bool               enableSneakStaminaCost;
-    bool               enableLevelDifficulty;
-    bool               zeroAllWeapStagger;
-    bool               armorScalingEnabled;
     bool               IsBlockingWeaponSpellCasted = false;
     bool               wasPowerAttacking           = false;
-    inline static bool debug_logging{};
     // floats
-    inline static float BonusXPPerLevel;
-    inline static float BaseXP;
     float               blockAngleSetting;
-    float               surroundingActorsRange;
     // int
     inline static uint32_t blockingKey[RE::INPUT_DEVICE::kFlatTotal] = { 0xFF, 0xFF, 0xFF };
     inline static uint32_t blockKeyMouse{ 0xFF };
     inline static uint32_t blockKeyKeyboard{ 0xFF };
     inline static uint32_t blockKeyGamePad{ 0xFF };
-    int                    maxFrameCheck = 6;
-    static inline uint32_t               dualBlockKey;
-    static inline std::string colorCodeStaminaPenalty;
-    static inline uint32_t uColorCodeStamBar = 0xDF2020;
     static inline float dmgModifierMaxEnemy = 1.5f;
     static inline float dmgModifierMidEnemy = 1.3f;
     static inline float dmgModifierMinEnemy = 1.15f;
@@ -92,4 +115,10 @@ public:
     static RE::FormID ParseFormID(const std::string& str);
 
     std::string FileName;
+
+private:
+    std::unique_ptr<const Config> ParseConfig() const;
+    void                          Publish(std::unique_ptr<const Config> a_config);
+
+    Core::Snapshot<Config> config;
 };
@@ -0,0 +1,154 @@
+#pragma once
+#include "Conditions.h"
+#include "PlayerStateTracker.h"
+
+// Remembers which state spells UpdateManager has applied to the player and to the mount the
+// player last sprinted on, so toggling a state is a bit test instead of a HasSpell engine call.
+// The plugin owns these spells, so the shadow only drifts when the game state is replaced:
+// it is resynced from the engine after a save is loaded and when the player switches race.
+class StateSpellShadow :
+    public EventSingleton<StateSpellShadow, RE::TESSwitchRaceCompleteEvent>
+{
+public:
+    enum Spell : std::uint32_t
+    {
+        kCasting,
+        kBowStamina,
+        kXbowStamina,
+        kAttacking,
+        kBlocking,
+        kSneaking,
+        kSprinting,
+        kMountSprinting,
+
+        kTotal
+    };
+
+    // Returns true when the spell was added
+    bool Add(RE::Actor* a_actor, Spell a_spell)
+    {
+        auto spell = GetSpell(a_spell);
+        auto bits  = GetBits(a_actor);
+        if (!spell || !bits || bits->test(a_spell)) {
+            return false;
+        }
+        bits->set(a_spell);
+        a_actor->AddSpell(spell);
+        return true;
+    }
+
+    // Returns true when the spell was removed
+    bool Remove(RE::Actor* a_actor, Spell a_spell)
+    {
+        auto spell = GetSpell(a_spell);
+        auto bits  = GetBits(a_actor);
+        if (!spell || !bits || !bits->test(a_spell)) {
+            return false;
+        }
+        bits->reset(a_spell);
+        a_actor->RemoveSpell(spell);
+        return true;
+    }
+
+    bool Has(RE::Actor* a_actor, Spell a_spell) const
+    {
+        const auto bits = GetBits(a_actor);
+        return bits && bits->test(a_spell);
+    }
+
+    void RemoveAll(RE::Actor* a_actor)
+    {
+        for (std::uint32_t i = 0; i < kTotal; ++i) {
+            Remove(a_actor, static_cast<Spell>(i));
+        }
+    }
+
+    // Rebuilds the player bits from the engine and forgets the mount
+    void Resync()
+    {
+        auto player = Cache::GetPlayerSingleton();
+        playerBits.reset();
+        mountBits.reset();
+        mount.reset();
+        if (!player) {
+            return;
+        }
+        for (std::uint32_t i = 0; i < kTotal; ++i) {
+            if (auto spell = GetSpell(static_cast<Spell>(i)); spell && Conditions::HasSpell(player, spell)) {
+                playerBits.set(i);
+            }
+        }
+        PlayerStateTracker::GetSingleton()->MarkAllDirty();
+        dlog("resynced state spells, player has {:#x}", playerBits.to_ulong());
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESSwitchRaceCompleteEvent* a_event, RE::BSTEventSource<RE::TESSwitchRaceCompleteEvent>*) override
+    {
+        if (a_event && a_event->subject && a_event->subject->IsPlayerRef()) {
+            Resync();
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+private:
+    using Bits = std::bitset<kTotal>;
+
+    Bits            playerBits;
+    Bits            mountBits;
+    RE::ActorHandle mount;
+
+    static RE::SpellItem* GetSpell(Spell a_spell)
+    {
+        const auto settings = Settings::GetSingleton();
+        switch (a_spell) {
+        case kCasting:
+            return settings->IsCastingSpell;
+        case kBowStamina:
+            return settings->BowStaminaSpell;
+        case kXbowStamina:
+            return settings->XbowStaminaSpell;
+        case kAttacking:
+            return settings->IsAttackingSpell;
+        case kBlocking:
+            return settings->IsBlockingSpell;
+        case kSneaking:
+            return settings->IsSneakingSpell;
+        case kSprinting:
+            return settings->IsSprintingSpell;
+        case kMountSprinting:
+            return settings->MountSprintingSpell;
+        default:
+            return nullptr;
+        }
+    }
+
+    // A mount the shadow has not seen yet is read from the engine once
+    Bits* GetBits(RE::Actor* a_actor)
+    {
+        if (!a_actor) {
+            return nullptr;
+        }
+        if (a_actor->IsPlayerRef()) {
+            return &playerBits;
+        }
+        if (mount.get().get() != a_actor) {
+            mount = a_actor->GetHandle();
+            mountBits.reset();
+            if (auto spell = GetSpell(kMountSprinting); spell && Conditions::HasSpell(a_actor, spell)) {
+                mountBits.set(kMountSprinting);
+            }
+        }
+        return &mountBits;
+    }
+
+    const Bits* GetBits(RE::Actor* a_actor) const
+    {
+        if (!a_actor) {
+            return nullptr;
+        }
+        if (a_actor->IsPlayerRef()) {
+            return &playerBits;
+        }
+        return mount.get().get() == a_actor ? &mountBits : nullptr;
+    }
+};
@@ -0,0 +1,42 @@
+#include "TelemetryRecorder.h"
+
+#include <Windows.h>
+
+bool TelemetryRecorder::Open(std::uint32_t a_capacity)
+{
+    if (!a_capacity || Active()) {
+        return false;
+    }
+
+    auto path = SKSE::log::log_directory();
+    if (!path) {
+        return false;
+    }
+    *path /= "paragon-perks-telemetry.bin";
+
+    const auto size = Core::TelemetryFileSize(a_capacity);
+    file            = ::CreateFileW(path->c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        logger::error("telemetry: could not create {}", path->string());
+        return false;
+    }
+
+    mapping = ::CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    auto view = mapping ? ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size) : nullptr;
+    if (!view) {
+        logger::error("telemetry: could not map {} bytes", size);
+        if (mapping) {
+            ::CloseHandle(mapping);
+            mapping = nullptr;
+        }
+        ::CloseHandle(file);
+        file = nullptr;
+        return false;
+    }
+
+    opened = std::chrono::steady_clock::now();
+    writer.Attach(view, a_capacity);
+    logger::info("telemetry: recording up to {} records into {}", a_capacity, path->string());
+    return true;
+}
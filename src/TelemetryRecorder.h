@@ -0,0 +1,43 @@
+#pragma once
+#include "Core/Telemetry.h"
+
+// Records the inputs and results of the combat formulas into <SKSE logs>/paragon-perks-telemetry.bin
+// for tools/replay.cpp. Off unless iTelemetryRecords is above 0; the file is mapped once at plugin
+// load with room for that many 40 byte records and the hooks write straight into the mapped view,
+// the OS pages it out. A full file silently stops recording, the size is not hot reloadable.
+class TelemetryRecorder
+{
+public:
+    static TelemetryRecorder* GetSingleton()
+    {
+        static TelemetryRecorder singleton;
+        return &singleton;
+    }
+
+    bool Open(std::uint32_t a_capacity);
+
+    bool Active() const noexcept { return writer.Active(); }
+
+    void Record(Core::TelemetryKind a_kind, std::uint8_t a_flags, std::initializer_list<float> a_in, float a_out) noexcept
+    {
+        if (!writer.Active()) {
+            return;
+        }
+
+        Core::TelemetryRecord record{};
+        record.timeMs = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - opened).count());
+        record.kind   = a_kind;
+        record.flags  = a_flags;
+        std::copy_n(a_in.begin(), std::min(a_in.size(), std::size(record.in)), record.in);
+        record.out = a_out;
+        writer.Write(record);
+    }
+
+private:
+    TelemetryRecorder() = default;
+
+    Core::TelemetryWriter                 writer;
+    std::chrono::steady_clock::time_point opened;
+    void*                                 file{ nullptr };
+    void*                                 mapping{ nullptr };
+};
@@ -1,8 +1,17 @@
 #pragma once
 
+#include "ActorSpatialIndex.h"
+#include "ActorUpdateScheduler.h"
+#include "BarColorTable.h"
 #include "Cache.h"
 #include "Conditions.h"
 #include "Hooks.h"
+#include "HookProfiler.h"
+#include "Jobs.h"
+#include "ParryResolver.h"
+#include "PlayerStateTracker.h"
+#include "StateSpellShadow.h"
+#include "VolleyLauncher.h"
 
 static float lastTime;
 
@@ -11,171 +20,180 @@ using namespace Conditions;
 class UpdateManager
 {
 public:
-    inline static int frameCount;
-
     inline static bool Install()
     {
         auto& trampoline = SKSE::GetTrampoline();
         _OnFrameFunction = trampoline.write_call<5>(Hooks::OnFrame_Update_Hook.address(), OnFrameUpdate);
 
-        UpdateManager::frameCount = 0;
         logger::info("Installed hook for frame update");
         return true;
     }
 
 private:
+    using State = PlayerStateTracker::State;
+    using Spell = StateSpellShadow::Spell;
+
+    inline static bool wasGodMode{ false };
+
     inline static std::int32_t OnFrameUpdate(std::int64_t a1)
     {
-        auto settings = Settings::GetSingleton();
+        Jobs::Drain();
+        UpdateFrame();
+        HookProfiler::Tick(Settings::Values().profileDumpSeconds);
+        return _OnFrameFunction(a1);
+    }
 
-        if (UpdateManager::frameCount > settings->maxFrameCheck) {
-            UpdateManager::frameCount = 0;
+    static void UpdateFrame()
+    {
+        HookProfiler::Scope profile(HookProfiler::Probe::kFrameUpdate);
+
+        auto        settings = Settings::GetSingleton();
+        const auto& config   = Settings::Values();
+        ActorSpatialIndex::GetSingleton()->Invalidate();
+        ActorUpdateScheduler::GetSingleton()->BeginFrame();
+
+        RE::PlayerCharacter* player  = Cache::GetPlayerSingleton();
+        auto                 tracker = PlayerStateTracker::GetSingleton();
+        auto                 spells  = StateSpellShadow::GetSingleton();
+
+        auto barColors = BarColorTable::GetSingleton();
+        barColors->SetGreyedOut(player, Conditions::PlayerHasActiveMagicEffect(settings->StaminaPenaltyEffect));
+        barColors->Flush();
+        VolleyLauncher::GetSingleton()->Update(config.volleyShotsPerFrame);
+        ParryResolver::GetSingleton()->Update(config.parryStaggersPerFrame);
+
+        if (player->IsGodMode()) {
+            if (!wasGodMode) {
+                wasGodMode = true;
+                spells->RemoveAll(player);
+            }
         }
         else {
-            RE::PlayerCharacter* player       = Cache::GetPlayerSingleton();
-            auto                 playerCamera = RE::PlayerCamera::GetSingleton();
+            if (wasGodMode) {
+                wasGodMode = false;
+                tracker->MarkAllDirty();
+            }
+
+            tracker->OnActorState(player->AsActorState());
+            const auto due          = tracker->Consume(config.stateReconcileFrames);
+            auto       playerCamera = RE::PlayerCamera::GetSingleton();
 
-            if (Conditions::PlayerHasActiveMagicEffect(settings->StaminaPenaltyEffect)) {
-                Conditions::greyoutAvMeter(player, RE::ActorValue::kStamina);
+            if (due & PlayerStateTracker::Bit(State::kCasting)) {
+                UpdateCasting(player, spells);
+            }
+            if (due & PlayerStateTracker::Bit(State::kBowDraw)) {
+                UpdateBowDraw(player, playerCamera, spells);
+            }
+            if (due & PlayerStateTracker::Bit(State::kXbowDraw)) {
+                UpdateXbowDraw(player, playerCamera, spells);
             }
-            if (!Conditions::PlayerHasActiveMagicEffect(settings->StaminaPenaltyEffect)) {
-                Conditions::revertAvMeter(player, RE::ActorValue::kStamina);
+            if (due & PlayerStateTracker::Bit(State::kAttackBlock)) {
+                UpdateAttackBlock(player, settings, spells);
             }
+            if (due & PlayerStateTracker::Bit(State::kSneaking)) {
+                UpdateSneaking(player, settings, spells);
+            }
+            if (due & PlayerStateTracker::Bit(State::kSprinting)) {
+                UpdateSprinting(player, spells);
+            }
+        }
+    }
 
-            if (player->IsGodMode()) {
-                if (settings->IsCastingSpell)
-                    player->RemoveSpell(settings->IsCastingSpell);
+    static void UpdateCasting(RE::PlayerCharacter* player, StateSpellShadow* spells)
+    {
+        if (player->IsCasting(nullptr)) {
+            spells->Add(player, Spell::kCasting);
+        }
+        else {
+            spells->Remove(player, Spell::kCasting);
+        }
+    }
 
-                if (settings->BowStaminaSpell)
-                    player->RemoveSpell(settings->BowStaminaSpell);
+    static void UpdateBowDraw(RE::PlayerCharacter* player, RE::PlayerCamera* playerCamera, StateSpellShadow* spells)
+    {
+        if (IsBowDrawNoZoomCheck(player, playerCamera)) {
+            spells->Add(player, Spell::kBowStamina);
+        }
+        else {
+            spells->Remove(player, Spell::kBowStamina);
+        }
+    }
 
-                if (settings->IsAttackingSpell)
-                    player->RemoveSpell(settings->IsAttackingSpell);
+    static void UpdateXbowDraw(RE::PlayerCharacter* player, RE::PlayerCamera* playerCamera, StateSpellShadow* spells)
+    {
+        if (IsXbowDrawCheck(player, playerCamera)) {
+            spells->Add(player, Spell::kXbowStamina);
+        }
+        else {
+            spells->Remove(player, Spell::kXbowStamina);
+        }
+    }
 
-                if (settings->XbowStaminaSpell)
-                    player->RemoveSpell(settings->XbowStaminaSpell);
+    static void UpdateAttackBlock(RE::PlayerCharacter* player, Settings* settings, StateSpellShadow* spells)
+    {
+        if (IsAttacking(player)) {
+            spells->Add(player, Spell::kAttacking);
 
-                if (settings->IsSneakingSpell)
-                    player->RemoveSpell(settings->IsSneakingSpell);
+            settings->wasPowerAttacking = Conditions::IsPowerAttacking(player);
+        }
+        else {
+            spells->Remove(player, Spell::kAttacking);
 
-                if (settings->IsSprintingSpell)
-                    player->RemoveSpell(settings->IsSprintingSpell);
+            if (settings->wasPowerAttacking) {
+                settings->wasPowerAttacking = false;
+                Conditions::ApplySpell(player, player, settings->PowerAttackStopSpell);
             }
-            else {
-                switch (UpdateManager::frameCount) {
-                case 1:
-                    if (player->IsCasting(nullptr)) {
-                        if (settings->IsCastingSpell && !HasSpell(player, settings->IsCastingSpell)) {
-                            player->AddSpell(settings->IsCastingSpell);
-                        }
-                    }
-                    else if (settings->IsCastingSpell && HasSpell(player, settings->IsCastingSpell)) {
-                        player->RemoveSpell(settings->IsCastingSpell);
-                    }
-                    break;
-                case 2:
-                    if (IsBowDrawNoZoomCheck(player, playerCamera)) {
-                        if (!HasSpell(player, settings->BowStaminaSpell)) {
-                            player->AddSpell(settings->BowStaminaSpell);
-                        }
-                    }
-                    else if (HasSpell(player, settings->BowStaminaSpell)) {
-                        player->RemoveSpell(settings->BowStaminaSpell);
-                    }
-                    break;
-                case 3:
-                    if (IsXbowDrawCheck(player, playerCamera)) {
-                        if (!HasSpell(player, settings->XbowStaminaSpell)) {
-                            player->AddSpell(settings->XbowStaminaSpell);
-                        }
-                    }
-                    else if (HasSpell(player, settings->XbowStaminaSpell)) {
-                        player->RemoveSpell(settings->XbowStaminaSpell);
-                    }
-                    break;
-                case 4:
-                    if (IsAttacking(player)) {
-                        if (!HasSpell(player, settings->IsAttackingSpell)) {
-                            player->AddSpell(settings->IsAttackingSpell);
-                        }
-
-                        settings->wasPowerAttacking = Conditions::IsPowerAttacking(player);
-                    }
-                    else {
-                        if (HasSpell(player, settings->IsAttackingSpell)) {
-                            player->RemoveSpell(settings->IsAttackingSpell);
-                        }
-
-                        if (settings->wasPowerAttacking) {
-                            settings->wasPowerAttacking = false;
-                            Conditions::ApplySpell(player, player, settings->PowerAttackStopSpell);
-                        }
-                        if (HasSpell(player, settings->IsAttackingSpell)) {
-                            player->RemoveSpell(settings->IsAttackingSpell);
-                        }
-
-                        if (IsBlocking(player)) {
-                            auto leftHand = player->GetEquippedObject(true);
-                            // Parry setup
-                            if ((!leftHand || leftHand->IsWeapon() || leftHand->IsArmor()) && !settings->IsBlockingWeaponSpellCasted) {
-                                settings->IsBlockingWeaponSpellCasted = true;
-                            }
-
-                            if (!HasSpell(player, settings->IsBlockingSpell)) {
-                                player->AddSpell(settings->IsBlockingSpell);
-                            }
-                        }
-                        else {
-                            if (HasSpell(player, settings->IsBlockingSpell)) {
-                                player->RemoveSpell(settings->IsBlockingSpell);
-                            }
-                            settings->IsBlockingWeaponSpellCasted = false;
-                        }
-                    }
-                    break;
-                case 5:
-                    if (player->IsSneaking() && IsMoving(player)) {
-                        if (!HasSpell(player, settings->IsSneakingSpell) && settings->enableSneakStaminaCost)
-                            player->AddSpell(settings->IsSneakingSpell);
-                    }
-                    else if (HasSpell(player, settings->IsSneakingSpell)) {
-                        player->RemoveSpell(settings->IsSneakingSpell);
-                    }
-                    break;
-                case 6: {
-                    // Cache mount and remove spell if not mounted
-                    auto* state = player->AsActorState();
-                    if (state->IsSprinting()) {
-                        if (!HasSpell(player, settings->IsSprintingSpell))
-                            player->AddSpell(settings->IsSprintingSpell);
-
-                        RE::ActorPtr mount = nullptr;
-
-                        GetMount(player, &mount);
-                        if (mount) {
-                            mount->AddSpell(settings->MountSprintingSpell);
-                        }
-                    }
-                    else if (HasSpell(player, settings->IsSprintingSpell)) {
-                        player->RemoveSpell(settings->IsSprintingSpell);
-
-                        
-                        RE::ActorPtr mount = nullptr;
-                        GetMount(player, &mount);
-
-                        if (mount) {
-                            dlog("on mount {}", mount->GetName());
-                            mount->RemoveSpell(settings->MountSprintingSpell);
-                        }
-                    }
-                } break;
-                default:
-                    break;
+
+            if (IsBlocking(player)) {
+                auto leftHand = player->GetEquippedObject(true);
+                // Parry setup
+                if ((!leftHand || leftHand->IsWeapon() || leftHand->IsArmor()) && !settings->IsBlockingWeaponSpellCasted) {
+                    settings->IsBlockingWeaponSpellCasted = true;
                 }
+
+                spells->Add(player, Spell::kBlocking);
+            }
+            else {
+                spells->Remove(player, Spell::kBlocking);
+                settings->IsBlockingWeaponSpellCasted = false;
+            }
+        }
+    }
+
+    static void UpdateSneaking(RE::PlayerCharacter* player, Settings* settings, StateSpellShadow* spells)
+    {
+        if (player->IsSneaking() && IsMoving(player)) {
+            if (Settings::Values().enableSneakStaminaCost)
+                spells->Add(player, Spell::kSneaking);
+        }
+        else {
+            spells->Remove(player, Spell::kSneaking);
+        }
+    }
+
+    static void UpdateSprinting(RE::PlayerCharacter* player, StateSpellShadow* spells)
+    {
+        // Cache mount and remove spell if not mounted
+        auto* state = player->AsActorState();
+        if (state->IsSprinting()) {
+            spells->Add(player, Spell::kSprinting);
+
+            RE::ActorPtr mount = nullptr;
+
+            GetMount(player, &mount);
+            if (mount) {
+                spells->Add(mount.get(), Spell::kMountSprinting);
+            }
+        }
+        else if (spells->Remove(player, Spell::kSprinting)) {
+            RE::ActorPtr mount = nullptr;
+            GetMount(player, &mount);
+
+            if (mount) {
+                dlog("on mount {}", mount->GetName());
+                spells->Remove(mount.get(), Spell::kMountSprinting);
             }
         }
-        UpdateManager::frameCount++;
-        return _OnFrameFunction(a1);
     }
 
     static bool GetMount(RE::Actor* a_actor, RE::ActorPtr* a_mountOut)
@@ -0,0 +1,215 @@
+#pragma once
+#include "Conditions.h"
+#include "Jobs.h"
+
+// Launches arrow volleys (arrow rain) spread over several frames.
+// Launch() snapshots the shooter, ammo, weapon, poison and both positions once and solves every
+// trajectory of the pattern in one batch from uniform disc samples on the worker pool, the solved
+// volley is committed at the start of the next frame and the frame hook then fires at most
+// iVolleyShotsPerFrame projectiles per frame, so a 75 arrow volley no longer means 75 separately
+// queued tasks in a single frame. Shot buffers of finished volleys are kept and reused by the next one.
+class VolleyLauncher
+{
+public:
+    struct Pattern
+    {
+        std::uint32_t count;
+        float         radius; // landing area around the target
+        float         height; // launch height above the start actor
+        float         spread; // launch area around the start point, 0 fires everything from one point
+    };
+
+    static VolleyLauncher* GetSingleton()
+    {
+        static VolleyLauncher singleton;
+        return &singleton;
+    }
+
+    void Launch(RE::Actor* a_shooter, RE::TESAmmo* a_ammo, RE::TESObjectWEAP* a_weapon, RE::AlchemyItem* a_poison, RE::Actor* a_startActor, RE::Actor* a_target,
+                const Pattern& a_pattern)
+    {
+        if (!a_shooter || !a_ammo || !a_startActor || !a_target || !a_pattern.count) {
+            return;
+        }
+
+        Volley volley;
+        volley.shooter = a_shooter->GetHandle();
+        volley.target  = a_target->GetHandle();
+        volley.ammo    = a_ammo;
+        volley.weapon  = a_weapon;
+        volley.poison  = a_poison;
+        {
+            std::lock_guard lock(mutex);
+            volley.shots = TakeBuffer();
+        }
+
+        const auto start  = a_startActor->GetPosition() + RE::NiPoint3{ 0.0f, 0.0f, a_pattern.height };
+        const auto center = a_target->GetPosition();
+        // seeded here, on the calling thread, so a fixed iRandomSeed replays the same volleys
+        // whichever worker ends up solving them
+        const auto seed = (static_cast<std::uint64_t>(Core::ThreadRng().Next()) << 32) | Core::ThreadRng().Next();
+
+        Jobs::Run(
+            [volley = std::move(volley), a_pattern, start, center, seed]() mutable {
+                Solve(volley.shots, a_pattern, start, center, seed);
+                return std::move(volley);
+            },
+            [this](Volley a_volley) {
+                std::lock_guard lock(mutex);
+                volleys.push_back(std::move(a_volley));
+            });
+    }
+
+    // Called from the frame hook on the main thread
+    void Update(std::uint32_t a_shotsPerFrame)
+    {
+        std::lock_guard lock(mutex);
+        if (volleys.empty()) {
+            return;
+        }
+
+        std::uint32_t budget = a_shotsPerFrame ? a_shotsPerFrame : std::numeric_limits<std::uint32_t>::max();
+        for (auto it = volleys.begin(); it != volleys.end() && budget;) {
+            auto shooter = it->shooter.get();
+            if (shooter && !shooter->IsDead()) {
+                auto ldata = MakeLaunchData(*it, shooter.get());
+                for (; it->next < it->shots.size() && budget; ++it->next, --budget) {
+                    const auto& shot = it->shots[it->next];
+                    ldata.origin     = shot.origin;
+                    ldata.angleX     = shot.angleX;
+                    ldata.angleZ     = shot.angleZ;
+
+                    RE::BSPointerHandle<RE::Projectile> handle;
+                    RE::Projectile::Launch(&handle, ldata);
+                }
+                if (it->next < it->shots.size()) {
+                    ++it;
+                    continue;
+                }
+            }
+            ReturnBuffer(std::move(it->shots));
+            it = volleys.erase(it);
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard lock(mutex);
+        for (auto& volley : volleys) {
+            ReturnBuffer(std::move(volley.shots));
+        }
+        volleys.clear();
+    }
+
+private:
+    struct Shot
+    {
+        RE::NiPoint3 origin;
+        float        angleX;
+        float        angleZ;
+    };
+
+    struct Volley
+    {
+        RE::ActorHandle    shooter;
+        RE::ActorHandle    target;
+        RE::TESAmmo*       ammo{ nullptr };
+        RE::TESObjectWEAP* weapon{ nullptr };
+        RE::AlchemyItem*   poison{ nullptr };
+        std::vector<Shot>  shots;
+        std::size_t        next{ 0 };
+    };
+
+    // Worker thread: pure math only, no engine calls
+    static void Solve(std::vector<Shot>& a_shots, const Pattern& a_pattern, const RE::NiPoint3& a_start, const RE::NiPoint3& a_center, std::uint64_t a_seed)
+    {
+        thread_local std::vector<Core::Rng::DiscPoint> landing;
+        thread_local std::vector<Core::Rng::DiscPoint> launch;
+
+        Core::Rng rng(a_seed);
+        landing.resize(a_pattern.count);
+        rng.FillDisc(landing, a_pattern.radius);
+        launch.assign(a_pattern.count, {});
+        if (a_pattern.spread > 0.0f) {
+            rng.FillDisc(launch, a_pattern.spread);
+        }
+
+        a_shots.reserve(a_pattern.count);
+        for (std::uint32_t i = 0; i < a_pattern.count; ++i) {
+            const RE::NiPoint3 origin{ a_start.x + launch[i].x, a_start.y + launch[i].y, a_start.z };
+            const RE::NiPoint3 end{ a_center.x + landing[i].x, a_center.y + landing[i].y, a_center.z };
+
+            a_shots.push_back({ origin, Pitch(end - origin), Heading(end - origin) });
+        }
+    }
+
+    // Same angles as Conditions::rot_at, the heading without its engine helper: 0 faces +y and
+    // grows towards +x, in [0, 2pi)
+    static float Pitch(const RE::NiPoint3& a_direction)
+    {
+        const auto length = a_direction.Length();
+        return length > 0.0f ? -std::asin(a_direction.z / length) : 0.0f;
+    }
+
+    static float Heading(const RE::NiPoint3& a_direction)
+    {
+        if (a_direction.x == 0.0f && a_direction.y == 0.0f) {
+            return 0.0f;
+        }
+        const auto heading = std::atan2(a_direction.x, a_direction.y);
+        return heading < 0.0f ? heading + 2.0f * std::numbers::pi_v<float> : heading;
+    }
+
+    // Everything but origin and angles is the same for every shot of a volley
+    static RE::Projectile::LaunchData MakeLaunchData(const Volley& a_volley, RE::Actor* a_shooter)
+    {
+        RE::Projectile::LaunchData ldata;
+        ldata.contactNormal         = { 0.0f, 0.0f, 0.0f };
+        ldata.projectileBase        = a_volley.ammo->GetRuntimeData().data.projectile;
+        ldata.shooter               = a_shooter;
+        ldata.combatController      = a_shooter->GetActorRuntimeData().combatController;
+        ldata.weaponSource          = a_volley.weapon;
+        ldata.ammoSource            = a_volley.ammo;
+        ldata.unk50                 = nullptr;
+        ldata.desiredTarget         = a_volley.target.get().get();
+        ldata.unk60                 = 0.0f;
+        ldata.unk64                 = 0.0f;
+        ldata.parentCell            = a_shooter->GetParentCell();
+        ldata.spell                 = nullptr;
+        ldata.castingSource         = RE::MagicSystem::CastingSource::kOther;
+        ldata.pad7C                 = 0;
+        ldata.enchantItem           = nullptr;
+        ldata.poison                = a_volley.poison;
+        ldata.area                  = 0;
+        ldata.power                 = 1.0f;
+        ldata.scale                 = 1.0f;
+        ldata.alwaysHit             = false;
+        ldata.noDamageOutsideCombat = false;
+        ldata.autoAim               = false;
+        ldata.chainShatter          = false;
+        ldata.useOrigin             = true;
+        ldata.deferInitialization   = false;
+        ldata.forceConeOfFire       = false;
+        return ldata;
+    }
+
+    std::vector<Shot> TakeBuffer()
+    {
+        if (pool.empty()) {
+            return {};
+        }
+        auto buffer = std::move(pool.back());
+        pool.pop_back();
+        return buffer;
+    }
+
+    void ReturnBuffer(std::vector<Shot>&& a_buffer)
+    {
+        a_buffer.clear();
+        pool.push_back(std::move(a_buffer));
+    }
+
+    std::mutex                         mutex;
+    std::list<Volley>                  volleys;
+    std::vector<std::vector<Shot>>     pool;
+};
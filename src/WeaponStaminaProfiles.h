@@ -0,0 +1,103 @@
+#pragma once
+#include "Conditions.h"
+
+// HitFrame stamina cost inputs without re-deriving them on every swing.
+// The weapon class of every melee weapon in the load order is classified once at kDataLoaded
+// (weapons created at runtime, e.g. player enchanted ones, are classified on first use), and what
+// each actor holds in its hands is cached until the next equip event for that actor.
+class WeaponStaminaProfiles :
+    public EventSingleton<WeaponStaminaProfiles, RE::TESEquipEvent>
+{
+public:
+    struct Wielded
+    {
+        RE::TESObjectWEAP* weapon{ nullptr };
+        Core::WeaponClass  weaponClass{ Core::WeaponClass::kOther };
+        bool               dualWielding{ false };
+    };
+
+    void Build()
+    {
+        std::lock_guard lock(mutex);
+        classes.clear();
+        for (const auto weapon : RE::TESDataHandler::GetSingleton()->GetFormArray<RE::TESObjectWEAP>()) {
+            if (weapon && weapon->IsMelee()) {
+                classes.emplace(weapon, Conditions::GetWeaponClass(weapon));
+            }
+        }
+        logger::info("classified {} melee weapons for stamina costs", classes.size());
+    }
+
+    void Clear()
+    {
+        std::lock_guard lock(mutex);
+        hands.clear();
+    }
+
+    // Same weapon pick as Conditions::getWieldingWeapon, dual wielding as Conditions::IsDualWielding
+    Wielded GetWielded(RE::Actor* a_actor)
+    {
+        const auto attacking = a_actor->GetAttackingWeapon();
+
+        std::lock_guard lock(mutex);
+        auto            it = hands.find(a_actor->GetFormID());
+        if (it == hands.end()) {
+            it = hands.emplace(a_actor->GetFormID(), ReadHands(a_actor)).first;
+        }
+        const auto& held = it->second;
+
+        Wielded result;
+        if (attacking) {
+            result.weapon = attacking->object ? attacking->object->As<RE::TESObjectWEAP>() : nullptr;
+        }
+        else {
+            result.weapon = held.right ? held.right : held.left;
+        }
+        result.dualWielding = attacking && held.right && held.left;
+
+        if (result.weapon && result.weapon->IsMelee()) {
+            result.weaponClass = GetClassLocked(result.weapon);
+        }
+        return result;
+    }
+
+    RE::BSEventNotifyControl ProcessEvent(const RE::TESEquipEvent* a_event, RE::BSTEventSource<RE::TESEquipEvent>*) override
+    {
+        if (a_event && a_event->actor) {
+            std::lock_guard lock(mutex);
+            hands.erase(a_event->actor->GetFormID());
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+private:
+    struct Hands
+    {
+        RE::TESObjectWEAP* right{ nullptr };
+        RE::TESObjectWEAP* left{ nullptr };
+    };
+
+    static Hands ReadHands(RE::Actor* a_actor)
+    {
+        Hands held;
+        if (auto rhs = a_actor->GetEquippedObject(false); rhs && rhs->IsWeapon()) {
+            held.right = rhs->As<RE::TESObjectWEAP>();
+        }
+        if (auto lhs = a_actor->GetEquippedObject(true); lhs && lhs->IsWeapon()) {
+            held.left = lhs->As<RE::TESObjectWEAP>();
+        }
+        return held;
+    }
+
+    Core::WeaponClass GetClassLocked(RE::TESObjectWEAP* a_weapon)
+    {
+        if (const auto it = classes.find(a_weapon); it != classes.end()) {
+            return it->second;
+        }
+        return classes.emplace(a_weapon, Conditions::GetWeaponClass(a_weapon)).first->second;
+    }
+
+    std::mutex                                                      mutex;
+    std::unordered_map<const RE::TESObjectWEAP*, Core::WeaponClass> classes;
+    std::unordered_map<RE::FormID, Hands>                           hands;
+};
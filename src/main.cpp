@@ -1,9 +1,15 @@
+#include "ActorUpdateScheduler.h"
+#include "BarColorTable.h"
 #include "Cache.h"
+#include "Core/InitGraph.h"
 #include "Events.h"
+#include "GameSettings.h"
 #include "Hooks.h"
 #include "InputHandler.h"
+#include "Jobs.h"
 #include "MenuEventHandler.h"
 #include "PickpocketReplace.h"
+#include "StateSpellShadow.h"
 
 void initTrueHUDAPI() {
     auto val = Conditions::APIuse::GetSingleton();
@@ -17,6 +23,34 @@ void initTrueHUDAPI() {
     }
 }
 
+namespace
+{
+    // Queues everything below warn for spdlog's background thread. Warnings and errors are written
+    // and flushed to the sinks on the calling thread so they are on disk even if the game crashes
+    // right after, at the price of landing ahead of info lines still in the queue (the timestamps
+    // keep the order readable).
+    class CrashSafeLogger : public spdlog::async_logger
+    {
+    public:
+        using spdlog::async_logger::async_logger;
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg& a_msg) override
+        {
+            if (a_msg.level < spdlog::level::level_enum::warn) {
+                spdlog::async_logger::sink_it_(a_msg);
+                return;
+            }
+            for (auto& sink : sinks_) {
+                if (sink->should_log(a_msg.level)) {
+                    sink->log(a_msg);
+                    sink->flush();
+                }
+            }
+        }
+    };
+} // namespace
+
 void InitLogger()
 {
     auto path{ SKSE::log::log_directory() };
@@ -25,26 +59,145 @@ void InitLogger()
     *path /= SKSE::PluginDeclaration::GetSingleton()->GetName();
     *path += L".log";
 
-    std::shared_ptr<spdlog::logger> log;
+    spdlog::sink_ptr sink;
     if (IsDebuggerPresent())
-        log = std::make_shared<spdlog::logger>("Global", std::make_shared<spdlog::sinks::msvc_sink_mt>());
+        sink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
     else
-        log = std::make_shared<spdlog::logger>("Global", std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true));
+        sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
+
+    // Lines are formatted into spdlog's queue and written by one background thread, a full queue
+    // drops the oldest lines instead of stalling a hook. Warnings and errors skip the queue (see
+    // CrashSafeLogger), everything else is flushed once a second.
+    spdlog::init_thread_pool(8192, 1);
+    auto log = std::make_shared<CrashSafeLogger>("Global", std::move(sink), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
 
     log->set_level(spdlog::level::level_enum::info);
-    log->flush_on(spdlog::level::level_enum::trace);
+    spdlog::flush_every(std::chrono::seconds(1));
 
     set_default_logger(std::move(log));
 
     spdlog::set_pattern("[%T.%e UTC%z] [%L] [%=5t] %v");
 }
 
-void InitListener(SKSE::MessagingInterface::Message* a_msg)
+namespace
 {
-    auto settings = Settings::GetSingleton();
+    using Affinity = Core::InitGraph::Affinity;
+
+    // Start up as two stage graphs, one when the plugin is loaded and one once the game data is.
+    // Independent stages run on the job pool while the loading thread works through its own
+    // chain, hooks, form writes and event sinks stay on the loading thread. Everything reading or
+    // writing forms finishes before our kDataLoaded handler returns, the main thread goes on to
+    // other plugins' handlers and the main menu over the same forms. Only stages touching nothing
+    // but plugin state are deferred, loading a save or starting a new game waits for them. Every
+    // stage logs its timing.
+    Core::InitGraph pluginLoad;
+    Core::InitGraph dataLoaded;
+
+    void LogStage(const Core::InitGraph::StageReport& a_stage)
+    {
+        switch (a_stage.result) {
+        case Core::InitGraph::Result::kOk:
+            logger::info(FMT_STRING("[init] {} took {:.3f} ms (at {:.3f} ms, {})"), a_stage.name, a_stage.ms, a_stage.startMs,
+                         a_stage.worker ? "worker" : "loading thread");
+            break;
+        case Core::InitGraph::Result::kFailed:
+            logger::error(FMT_STRING("[init] {} failed after {:.3f} ms"), a_stage.name, a_stage.ms);
+            break;
+        default:
+            logger::warn("[init] {} skipped, a stage it needs did not succeed", a_stage.name);
+            break;
+        }
+    }
+
+    void LogGraph(std::string_view a_name, const Core::InitGraph& a_graph)
+    {
+        logger::info(FMT_STRING("[init] {}: {:.3f} ms wall time for {:.3f} ms of stages"), a_name, a_graph.WallMs(), a_graph.StageMs());
+    }
+
+    void RunDataLoadedStages()
+    {
+        const auto settings = Settings::GetSingleton();
+
+        dataLoaded.Add("game settings", {}, Affinity::kCaller, [] {
+            GameSettings::Resolve();
+            return true;
+        });
+        // a missing required form skips everything after it, the sinks read those forms unchecked
+        dataLoaded.Add("form manifest", { "game settings" }, Affinity::kCaller, [settings] { return settings->LoadForms(); });
+        dataLoaded.Add("effect index", { "form manifest" }, Affinity::kCaller, [settings] {
+            ActiveEffectIndex::GetSingleton()->Track({ settings->StaminaPenaltyEffect, settings->StaminaPenEffectNPC, settings->MAG_ParryWindowEffect,
+                                                       settings->ArrowRainCooldownEffect, settings->MultiShotCooldownEffect });
+            return true;
+        });
+        // PatchRecords hands its chunks to the pool itself
+        dataLoaded.Add("weapon records", {}, Affinity::kCaller, [settings] {
+            settings->AdjustWeaponStaggerVals();
+            return true;
+        });
+        // only reads the weapon type, overlaps the loading thread's chain
+        dataLoaded.Add("stamina profiles", {}, Affinity::kWorker, [] {
+            WeaponStaminaProfiles::GetSingleton()->Build();
+            return true;
+        });
+        // the sinks read forms as soon as the first event comes in
+        dataLoaded.Add("event sinks", { "form manifest", "effect index" }, Affinity::kCaller, [] {
+            AnimationGraphEventHandler::Register();
+            AnimationGraphEventHandler::RegisterAnimHook();
+            OnHitEventHandler::Register();
+            PlayerStateTracker::Register();
+            StateSpellShadow::Register();
+            WeaponStaminaProfiles::Register();
+            ActiveEffectIndex::GetSingleton()->Register();
+            ActorUpdateScheduler::GetSingleton()->Register();
+            BarColorTable::GetSingleton()->Register();
+            Input::InputEventSink::Register();
+            Input::InputEventSink::GetSingleton()->GetMappedKey();
+            MenuEventHandler::MenuEvent::GetSingleton()->RegisterMenuEvents();
+            return true;
+        });
+        dataLoaded.Add("settings reload thread", { "event sinks" }, Affinity::kCaller, [settings] {
+            settings->StartReloadThread();
+            return true;
+        }, true);
 
+        if (!dataLoaded.Run(Jobs::Pool(), LogStage)) {
+            logger::error("Data loaded initialization failed.");
+        }
+        LogGraph("data loaded", dataLoaded);
+    }
+
+    // Before anything of a game runs, a no-op once the deferred stages are done
+    void FinishDataLoadedStages()
+    {
+        static std::once_flag logged;
+        dataLoaded.Wait();
+        std::call_once(logged, [] { LogGraph("data loaded, deferred stages included", dataLoaded); });
+    }
+} // namespace
+
+void InitListener(SKSE::MessagingInterface::Message* a_msg)
+{
+    if (a_msg->type == SKSE::MessagingInterface::kPreLoadGame) {
+        FinishDataLoadedStages();
+    }
     if (a_msg->type == SKSE::MessagingInterface::kPostLoadGame) {
+        GameSettings::Resolve();
         Settings::GetSingleton()->SetGlobalsAndGameSettings();
+        StateSpellShadow::GetSingleton()->Resync();
+        ActiveEffectIndex::GetSingleton()->Clear();
+        WeaponStaminaProfiles::GetSingleton()->Clear();
+        VolleyLauncher::GetSingleton()->Clear();
+        ParryResolver::GetSingleton()->Clear();
+        BarColorTable::GetSingleton()->Clear();
+    }
+    if (a_msg->type == SKSE::MessagingInterface::kNewGame) {
+        FinishDataLoadedStages();
+        StateSpellShadow::GetSingleton()->Resync();
+        ActiveEffectIndex::GetSingleton()->Clear();
+        WeaponStaminaProfiles::GetSingleton()->Clear();
+        VolleyLauncher::GetSingleton()->Clear();
+        ParryResolver::GetSingleton()->Clear();
+        BarColorTable::GetSingleton()->Clear();
     }
     if (a_msg->type == SKSE::MessagingInterface::kPostLoad) {
         initTrueHUDAPI();
@@ -56,16 +209,7 @@ void InitListener(SKSE::MessagingInterface::Message* a_msg)
         }
     }
     if (a_msg->type == SKSE::MessagingInterface::kDataLoaded) {
-        if (settings) {
-            settings->LoadForms();
-            settings->AdjustWeaponStaggerVals();
-        }
-        AnimationGraphEventHandler::Register();
-        AnimationGraphEventHandler::RegisterAnimHook();
-        OnHitEventHandler::Register();
-        Input::InputEventSink::Register();
-        Input::InputEventSink::GetSingleton()->GetMappedKey();
-        MenuEventHandler::MenuEvent::GetSingleton()->RegisterMenuEvents();
+        RunDataLoadedStages();
     }   
 }
 
@@ -82,19 +226,32 @@ SKSEPluginLoad(const SKSE::LoadInterface* skse)
     logger::info("{} {} loading...", plugin->GetName(), version);
 
     SKSE::AllocTrampoline(320);
-    Cache::CacheAddLibAddresses();
-    Settings::GetSingleton()->LoadSettings();
-    logger::debug("loaded settings with debug enabled");
-    if (!Hooks::InstallHooks()) {
-        logger::error("Hook installation failed.");
-        return false;
-    }
-    PickpocketReplace::Install();
-    
-    auto messaging = SKSE::GetMessagingInterface();
-    if (!messaging->RegisterListener(InitListener)) {
+    // address lookups and ini parsing overlap, hooks need both and go through the trampoline one by one
+    pluginLoad.Add("address cache", {}, Affinity::kWorker, [] {
+        Cache::CacheAddLibAddresses();
+        return true;
+    });
+    pluginLoad.Add("settings", {}, Affinity::kWorker, [] {
+        Settings::GetSingleton()->LoadSettings();
+        dlog("loaded settings with debug enabled");
+        return true;
+    });
+    pluginLoad.Add("hooks", { "address cache", "settings" }, Affinity::kCaller, [] {
+        if (!Hooks::InstallHooks()) {
+            logger::error("Hook installation failed.");
+            return false;
+        }
+        return true;
+    });
+    pluginLoad.Add("pickpocket", { "hooks" }, Affinity::kCaller, [] {
+        PickpocketReplace::Install();
+        return true;
+    });
+    pluginLoad.Add("listener", { "hooks" }, Affinity::kCaller, [] { return SKSE::GetMessagingInterface()->RegisterListener(InitListener); });
+    if (!pluginLoad.Run(Jobs::Pool(), LogStage)) {
         return false;
     }
+    LogGraph("plugin load", pluginLoad);
 
     logger::info("Valor Perks loaded.");
     spdlog::default_logger()->flush();
@@ -1,22 +1,14 @@
 #pragma once
 
+#include "GameSettings.h"
+#include "Settings.h"
+
 namespace ArmorRatingScaling
 {
     float AdjustArmorRating(float a_vanilla)
     {
-        auto factor      = RE::GameSettingCollection::GetSingleton()->GetSetting("fArmorScalingFactor")->GetFloat();
-        auto armorRating = (a_vanilla / factor) * 100;
-
-        if (armorRating <= 500) {
-            return a_vanilla;
-        }
-        else if (armorRating < 1000) {
-            auto remainderRating = armorRating - 500;
-            return 0.75f + (remainderRating / 100 * 0.03f);
-        }
-        else {
-            return 0.90f;
-        }
+        auto factor = GameSettings::GetFloat(GameSettings::ID::kArmorScalingFactor);
+        return Settings::Values().armorCurve.Evaluate(a_vanilla, factor);
     }
 
     bool InstallArmorRatingHookAE()
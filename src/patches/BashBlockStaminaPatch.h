@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Core/CombatRules.h"
+#include "GameSettings.h"
+#include "TelemetryRecorder.h"
+
 namespace BashBlockStaminaPatch
 {
     float GetStaminaDamage(RE::HitData* a_hitData)
@@ -8,29 +12,29 @@ namespace BashBlockStaminaPatch
             return 0.0f;
         }
 
-        auto staggerMult      = RE::GameSettingCollection::GetSingleton()->GetSetting("fStaminaBlockStaggerMult")->GetFloat();
-        auto stamBlockDmgMult = RE::GameSettingCollection::GetSingleton()->GetSetting("fStaminaBlockDmgMult")->GetFloat();
-        auto stamBlockBaseDmg = RE::GameSettingCollection::GetSingleton()->GetSetting("fStaminaBlockBase")->GetFloat();
+        using GameSettings::ID;
+
+        Core::BlockStaminaSettings blockSettings{ GameSettings::GetFloat(ID::kStaminaBlockStaggerMult),
+                                                  GameSettings::GetFloat(ID::kStaminaBlockDmgMult),
+                                                  GameSettings::GetFloat(ID::kStaminaBlockBase) };
 
-        float perkMult = 1.0f;
+        bool hasBlockPerk = false;
         if (a_hitData->target) {
             auto actorPtr = a_hitData->target.get();
             if (actorPtr.get()->IsPlayerRef()) {
                 auto perk = Settings::GetSingleton()->BlockStaminaPerk;
-                if (perk && actorPtr->HasPerk(Settings::GetSingleton()->BlockStaminaPerk)) {
-                    perkMult = 0.5f;
-                }
+                hasBlockPerk = perk && actorPtr->HasPerk(perk);
             }
         }
 
-        auto actualDmg = a_hitData->percentBlocked * a_hitData->physicalDamage;
-
         // NOTE: hitdata->stagger must be a float. Clib has it set to uint32_t which will mess things up. I changed it locally, but will need a PR to po3 clib
-        auto stagger        = a_hitData->stagger * staggerMult;
-        auto damagScaleStam = actualDmg * stamBlockDmgMult;
-        auto result         = (stagger + stamBlockBaseDmg + damagScaleStam) * perkMult;
-
-        return result;
+        const Core::BlockedHit input{ a_hitData->percentBlocked, a_hitData->physicalDamage, static_cast<float>(a_hitData->stagger), hasBlockPerk };
+        const auto             damage = Core::GetBlockStaminaDamage(blockSettings, input);
+        TelemetryRecorder::GetSingleton()->Record(Core::TelemetryKind::kBlockStamina, hasBlockPerk,
+                                                  { input.percentBlocked, input.physicalDamage, input.stagger, blockSettings.staggerMult, blockSettings.damageMult,
+                                                    blockSettings.base },
+                                                  damage);
+        return damage;
     }
 
     float GetAttackStamina(RE::ActorValueOwner* a_avOwner, RE::BGSAttackData* a_attackData)
@@ -41,25 +45,22 @@ namespace BashBlockStaminaPatch
 
         auto attackDataFlags = a_attackData->data.flags;
         auto powerAttack     = attackDataFlags.all(RE::AttackData::AttackFlag::kPowerAttack);
-        auto gameSettings    = RE::GameSettingCollection::GetSingleton();
+        using GameSettings::ID;
 
         RE::Actor* actor = &REL::RelocateMemberIfNewer<RE::Actor>(SKSE::RUNTIME_SSE_1_6_629, a_avOwner, -0xB0, -0xB8);
 
         if (a_attackData->data.flags.all(RE::AttackData::AttackFlag::kBashAttack)) {
-            static auto* staminaPowerBashBase = gameSettings->GetSetting("fStaminaPowerBashBase");
-            static auto* staminaBashBase      = gameSettings->GetSetting("fStaminaBashBase");
-
-            auto bashAttackStamina = powerAttack ? staminaPowerBashBase->GetFloat() : staminaBashBase->GetFloat();
-
-            float playerBashPerkMult = 1.0f;
+            bool hasBashPerk = false;
             if (actor && actor->IsPlayerRef()) {
                 auto perk = Settings::GetSingleton()->BashStaminaPerk;
-                if (perk && actor->HasPerk(perk)) {
-                    playerBashPerkMult = 0.5f;
-                }
+                hasBashPerk = perk && actor->HasPerk(perk);
             }
 
-            return (bashAttackStamina * a_attackData->data.staminaMult) * playerBashPerkMult;
+            const Core::BashStaminaSettings bashSettings{ GameSettings::GetFloat(ID::kStaminaBashBase), GameSettings::GetFloat(ID::kStaminaPowerBashBase) };
+            const auto                      stamina = Core::GetBashStamina(bashSettings, { a_attackData->data.staminaMult, powerAttack, hasBashPerk });
+            TelemetryRecorder::GetSingleton()->Record(Core::TelemetryKind::kBashStamina, static_cast<std::uint8_t>(powerAttack | hasBashPerk << 1),
+                                                      { a_attackData->data.staminaMult, bashSettings.bashBase, bashSettings.powerBashBase }, stamina);
+            return stamina;
         }
         else {
             if (!powerAttack) {
@@ -74,16 +75,21 @@ namespace BashBlockStaminaPatch
                 equippedWeapon = Conditions::GetUnarmedWeapon();
             }
 
-            static auto* staminaAttackWeaponBase       = gameSettings->GetSetting("fStaminaAttackWeaponBase");
-            static auto* staminaAttackWeaponMultiplier = gameSettings->GetSetting("fStaminaAttackWeaponMult");
-            static auto* powerAttackStaminaPenalty     = gameSettings->GetSetting("fPowerAttackStaminaPenalty");
-
-            auto powerAttackStamina
-                = (staminaAttackWeaponBase->GetFloat() + (equippedWeaponWeight * staminaAttackWeaponMultiplier->GetFloat())) * powerAttackStaminaPenalty->GetFloat();
+            const Core::PowerAttackStaminaSettings powerSettings{ GameSettings::GetFloat(ID::kStaminaAttackWeaponBase),
+                                                                 GameSettings::GetFloat(ID::kStaminaAttackWeaponMult),
+                                                                 GameSettings::GetFloat(ID::kPowerAttackStaminaPenalty) };
+            const auto                             baseStamina        = Core::GetPowerAttackBaseStamina(powerSettings, equippedWeaponWeight);
+            auto                                   powerAttackStamina = baseStamina;
 
             RE::BGSEntryPoint::HandleEntryPoint(RE::BGSEntryPoint::ENTRY_POINTS::kModPowerAttackStamina, actor, equippedWeapon, std::addressof(powerAttackStamina));
 
-            return powerAttackStamina * a_attackData->data.staminaMult;
+            const auto stamina = powerAttackStamina * a_attackData->data.staminaMult;
+            // the entry points are perk data the replayer does not have, it checks the base cost and keeps the final one for reference
+            TelemetryRecorder::GetSingleton()->Record(Core::TelemetryKind::kPowerAttackStamina, 0,
+                                                      { equippedWeaponWeight, powerSettings.weaponBase, powerSettings.weaponMult, powerSettings.powerAttackPenalty,
+                                                        a_attackData->data.staminaMult, stamina },
+                                                      baseStamina);
+            return stamina;
         }
     }
 
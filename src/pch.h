@@ -4,6 +4,7 @@
 #include <REL/Relocation.h>
 #include <SKSE/SKSE.h>
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/msvc_sink.h>
 
@@ -19,7 +20,23 @@ using namespace std::literals;
 using namespace REL::literals;
 
 namespace logger = SKSE::log;
-#define dlog logger::debug
+
+// Debug lines are checked against the logger level before their arguments are evaluated, so a
+// dlog in a hook costs one branch with Debug = false. Building with PARAGON_LOG_LEVEL above 1
+// (spdlog numbering, 1 = debug) compiles every dlog out, arguments included.
+#ifndef PARAGON_LOG_LEVEL
+#    define PARAGON_LOG_LEVEL 1
+#endif
+#if PARAGON_LOG_LEVEL <= 1
+#    define dlog(...)                                                                     \
+        do {                                                                              \
+            if (spdlog::default_logger_raw()->should_log(spdlog::level::debug)) {         \
+                logger::debug(__VA_ARGS__);                                               \
+            }                                                                             \
+        } while (0)
+#else
+#    define dlog(...) ((void)0)
+#endif
 
 
 template <typename T>
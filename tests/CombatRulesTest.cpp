@@ -0,0 +1,125 @@
+#include "Core/ArmorCurve.h"
+#include "Core/CombatRules.h"
+
+#include <cmath>
+#include <cstdio>
+#include <source_location>
+
+// Pins the combat rules to the values the plugin shipped with. Any change to a formula that moves
+// one of these numbers has to come with a deliberate update here.
+namespace
+{
+    int failures = 0;
+
+    void Check(double a_actual, double a_expected, const char* a_what, std::source_location a_where = std::source_location::current())
+    {
+        if (std::abs(a_actual - a_expected) > 1e-4) {
+            std::printf("%s:%u: %s: expected %.6f, got %.6f\n", a_where.file_name(), a_where.line(), a_what, a_expected, a_actual);
+            failures++;
+        }
+    }
+
+    void TestBlockStamina()
+    {
+        constexpr Core::BlockStaminaSettings block{ 2.0f, 0.5f, 10.0f };
+
+        // stagger 1.5 * 2 + base 10 + 50% of 40 damage * 0.5
+        Check(Core::GetBlockStaminaDamage(block, { 0.5f, 40.0f, 1.5f, false }), 23.0, "block without perk");
+        Check(Core::GetBlockStaminaDamage(block, { 0.5f, 40.0f, 1.5f, true }), 11.5, "block perk halves the cost");
+        Check(Core::GetBlockStaminaDamage(block, { 0.0f, 40.0f, 0.0f, false }), 10.0, "nothing blocked costs the base");
+    }
+
+    void TestBashStamina()
+    {
+        constexpr Core::BashStaminaSettings bash{ 25.0f, 40.0f };
+
+        Check(Core::GetBashStamina(bash, { 1.5f, false, false }), 37.5, "bash");
+        Check(Core::GetBashStamina(bash, { 1.0f, true, false }), 40.0, "power bash");
+        Check(Core::GetBashStamina(bash, { 1.0f, true, true }), 20.0, "bash perk halves the cost");
+    }
+
+    void TestPowerAttackStamina()
+    {
+        constexpr Core::PowerAttackStaminaSettings power{ 20.0f, 1.0f, 2.0f };
+
+        Check(Core::GetPowerAttackBaseStamina(power, 15.0f), 70.0, "power attack");
+        Check(Core::GetPowerAttackBaseStamina(power, 0.0f), 40.0, "unarmed power attack");
+    }
+
+    void TestArmorRating()
+    {
+        // with a scaling factor of 1 the rating is the vanilla value times 100
+        Check(Core::AdjustArmorRating(4.0f, 1.0f), 4.0, "below 500 keeps vanilla");
+        Check(Core::AdjustArmorRating(5.0f, 1.0f), 5.0, "500 still keeps vanilla");
+        Check(Core::AdjustArmorRating(5.01f, 1.0f), 0.7503, "just above 500");
+        Check(Core::AdjustArmorRating(7.5f, 1.0f), 0.825, "750");
+        Check(Core::AdjustArmorRating(9.99f, 1.0f), 0.8997, "just below 1000");
+        Check(Core::AdjustArmorRating(10.0f, 1.0f), 0.90, "1000 caps");
+        Check(Core::AdjustArmorRating(50.0f, 1.0f), 0.90, "far above 1000 caps");
+        Check(Core::AdjustArmorRating(0.9f, 0.12f), 0.825, "scaling factor divides the rating");
+
+        // the default sArmorCurve has to keep matching the old curve
+        const Core::ArmorCurve curve;
+        for (const auto vanilla : { 4.0f, 5.0f, 5.01f, 7.5f, 9.99f, 10.0f, 50.0f }) {
+            Check(curve.Evaluate(vanilla, 1.0f), Core::AdjustArmorRating(vanilla, 1.0f), "default armor curve");
+        }
+        // the settings reload skips a publish when the reparsed curve compares equal
+        Check(curve == Core::ArmorCurve::Compile(Core::defaultArmorCurve), 1.0, "recompiled default curve compares equal");
+    }
+
+    void TestPitFighter()
+    {
+        constexpr Core::PitFighterModifiers pitFighter{ 1.15f, 1.3f, 1.5f };
+
+        Check(Core::GetPitFighterMeleeMult(pitFighter, 0), 1.0, "melee without enemies");
+        Check(Core::GetPitFighterMeleeMult(pitFighter, -1), 1.0, "melee with a negative count");
+        Check(Core::GetPitFighterMeleeMult(pitFighter, 1), 1.15, "melee against one");
+        Check(Core::GetPitFighterMeleeMult(pitFighter, 2), 1.15, "melee against two");
+        Check(Core::GetPitFighterMeleeMult(pitFighter, 3), 1.3, "melee against three");
+        Check(Core::GetPitFighterMeleeMult(pitFighter, 4), 1.5, "melee against the max tier");
+        Check(Core::GetPitFighterMeleeMult(pitFighter, 12), 1.5, "melee above the max tier");
+
+        Check(Core::GetPitFighterRangedMult(pitFighter, 0), 1.5, "ranged without enemies");
+        Check(Core::GetPitFighterRangedMult(pitFighter, 1), 1.5, "ranged against one");
+        Check(Core::GetPitFighterRangedMult(pitFighter, 3), 1.3, "ranged against three");
+        Check(Core::GetPitFighterRangedMult(pitFighter, 4), 1.15, "ranged against the max tier");
+        Check(Core::GetPitFighterRangedMult(pitFighter, 12), 1.15, "ranged above the max tier");
+    }
+
+    void TestHitFrameStamina()
+    {
+        using enum Core::WeaponClass;
+        constexpr double global = 8.0;
+
+        Check(Core::GetHitFrameStaminaCost(kOther, false, true, global), 10.0, "other weapons cost a flat 10");
+        Check(Core::GetHitFrameStaminaCost(kOther, true, true, global), 10.0, "other weapons ignore dual wielding");
+        Check(Core::GetHitFrameStaminaCost(kOneHanded, false, true, global), 8.0, "one handed");
+        Check(Core::GetHitFrameStaminaCost(kOneHanded, true, true, global), 9.6, "player dual wielding one handed");
+        Check(Core::GetHitFrameStaminaCost(kTwoHanded, false, true, global), 12.0, "two handed");
+        Check(Core::GetHitFrameStaminaCost(kTwoHanded, true, true, global), 12.0, "two handed ignores dual wielding");
+        Check(Core::GetHitFrameStaminaCost(kDagger, false, true, global), 6.4, "dagger");
+        Check(Core::GetHitFrameStaminaCost(kDagger, true, true, global), 7.68, "player dual wielding daggers");
+        Check(Core::GetHitFrameStaminaCost(kHandToHand, true, true, global), 6.4, "hand to hand");
+
+        // npcs never paid the dual wield modifier
+        Check(Core::GetHitFrameStaminaCost(kOneHanded, true, false, global), 8.0, "npc dual wielding one handed");
+        Check(Core::GetHitFrameStaminaCost(kDagger, true, false, global), 6.4, "npc dual wielding daggers");
+    }
+} // namespace
+
+int main()
+{
+    TestBlockStamina();
+    TestBashStamina();
+    TestPowerAttackStamina();
+    TestArmorRating();
+    TestPitFighter();
+    TestHitFrameStamina();
+
+    if (failures != 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
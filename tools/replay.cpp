@@ -0,0 +1,245 @@
+// paragon-replay: feeds a recorded combat trace (iTelemetryRecords in paragon-perks.ini) through the
+// formulas in paragon-core.
+//
+//   paragon-replay <trace.bin> [--pit-fighter min,mid,max] [--block staggerMult,dmgMult,base]
+//                  [--bash base,powerBase] [--power-attack base,mult,penalty] [--hit-frame-mult x]
+//   paragon-replay --synthesize <trace.bin> <records>
+//
+// Without overrides every formula record must reproduce the recorded result, with overrides the
+// report shows how the mean result of each formula moves (A = recorded, B = overridden).
+#include "Core/Telemetry.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::array<const char*, static_cast<std::size_t>(Core::TelemetryKind::kTotal)> kindNames{
+        "block stamina", "bash stamina", "power attack stamina", "pit fighter melee", "pit fighter bow", "pit fighter spell", "hit frame stamina", "hit event",
+        "parry",
+    };
+
+    template <std::size_t N>
+    bool ParseFloats(const char* a_text, float (&a_out)[N])
+    {
+        const char* cursor = a_text;
+        for (std::size_t i = 0; i < N; ++i) {
+            char* end = nullptr;
+            a_out[i]  = std::strtof(cursor, &end);
+            if (end == cursor || (i + 1 < N && *end != ',')) {
+                return false;
+            }
+            cursor = end + 1;
+        }
+        return true;
+    }
+
+    std::vector<std::byte> ReadFile(const char* a_path)
+    {
+        std::ifstream file(a_path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return {};
+        }
+        std::vector<std::byte> data(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return data;
+    }
+
+    // A made up fight for trying the tool without the game: the same formulas the plugin calls,
+    // with vanilla-ish game settings and the plugin's default pit fighter modifiers
+    int Synthesize(const char* a_path, std::uint32_t a_count)
+    {
+        std::vector<std::byte> file(Core::TelemetryFileSize(a_count));
+        Core::TelemetryWriter  writer;
+        writer.Attach(file.data(), a_count);
+
+        std::mt19937                          rng(2024);
+        std::uniform_int_distribution<int>    kind(0, static_cast<int>(Core::TelemetryKind::kTotal) - 1);
+        std::uniform_int_distribution<int>    enemies(0, 6);
+        std::uniform_int_distribution<int>    bit(0, 1);
+        std::uniform_real_distribution<float> damage(5.0f, 60.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        const Core::BlockStaminaSettings       block{ 0.6f, 0.2f, 10.0f };
+        const Core::BashStaminaSettings        bash{ 30.0f, 45.0f };
+        const Core::PowerAttackStaminaSettings power{ 20.0f, 1.0f, 1.0f };
+        const Core::PitFighterModifiers        pit{ 1.15f, 1.3f, 1.5f };
+
+        for (std::uint32_t i = 0; i < a_count; ++i) {
+            Core::TelemetryRecord record{};
+            record.timeMs = i * 16;
+            record.kind   = static_cast<Core::TelemetryKind>(kind(rng));
+            record.flags  = static_cast<std::uint8_t>(bit(rng) | bit(rng) << 1 | bit(rng) << 2);
+            auto& in      = record.in;
+
+            switch (record.kind) {
+            case Core::TelemetryKind::kBlockStamina:
+                in[0] = unit(rng), in[1] = damage(rng), in[2] = unit(rng), in[3] = block.staggerMult, in[4] = block.damageMult, in[5] = block.base;
+                break;
+            case Core::TelemetryKind::kBashStamina:
+                in[0] = 0.5f + unit(rng), in[1] = bash.bashBase, in[2] = bash.powerBashBase;
+                break;
+            case Core::TelemetryKind::kPowerAttackStamina:
+                in[0] = 5.0f + unit(rng) * 20.0f, in[1] = power.weaponBase, in[2] = power.weaponMult, in[3] = power.powerAttackPenalty, in[4] = 1.0f;
+                break;
+            case Core::TelemetryKind::kPitFighterMelee:
+            case Core::TelemetryKind::kPitFighterBow:
+            case Core::TelemetryKind::kPitFighterSpell:
+                in[0] = damage(rng), in[1] = static_cast<float>(enemies(rng)), in[2] = pit.minEnemy, in[3] = pit.midEnemy, in[4] = pit.maxEnemy;
+                break;
+            case Core::TelemetryKind::kHitFrameStamina:
+                in[0] = static_cast<float>(1 + enemies(rng) % 4), in[1] = 8.0f;
+                break;
+            default:
+                in[0] = static_cast<float>(bit(rng));
+                break;
+            }
+            Core::ReplayTelemetry(record, {}, record.out);
+            if (record.kind == Core::TelemetryKind::kPowerAttackStamina) {
+                in[5] = record.out * in[4];
+            }
+            writer.Write(record);
+        }
+
+        std::ofstream out(a_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        std::printf("wrote %u synthetic records to %s\n", a_count, a_path);
+        return out ? 0 : 1;
+    }
+
+    struct KindStats
+    {
+        std::uint64_t records{ 0 };
+        std::uint64_t mismatches{ 0 };
+        double        recorded{ 0.0 };
+        double        replayed{ 0.0 };
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc >= 4 && std::strcmp(argv[1], "--synthesize") == 0) {
+        return Synthesize(argv[2], static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10)));
+    }
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: paragon-replay <trace.bin> [overrides] | --synthesize <trace.bin> <records>\n");
+        return 2;
+    }
+
+    Core::BlockStaminaSettings       block{};
+    Core::BashStaminaSettings        bash{};
+    Core::PowerAttackStaminaSettings power{};
+    Core::PitFighterModifiers        pit{};
+    Core::TelemetryOverrides         overrides;
+    bool                             ab = false;
+
+    for (int i = 2; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        const char*       value  = argv[i + 1];
+        bool              parsed = false;
+        if (option == "--pit-fighter") {
+            float v[3];
+            if ((parsed = ParseFloats(value, v))) {
+                pit                  = { v[0], v[1], v[2] };
+                overrides.pitFighter = &pit;
+            }
+        }
+        else if (option == "--block") {
+            float v[3];
+            if ((parsed = ParseFloats(value, v))) {
+                block           = { v[0], v[1], v[2] };
+                overrides.block = &block;
+            }
+        }
+        else if (option == "--bash") {
+            float v[2];
+            if ((parsed = ParseFloats(value, v))) {
+                bash           = { v[0], v[1] };
+                overrides.bash = &bash;
+            }
+        }
+        else if (option == "--power-attack") {
+            float v[3];
+            if ((parsed = ParseFloats(value, v))) {
+                power                 = { v[0], v[1], v[2] };
+                overrides.powerAttack = &power;
+            }
+        }
+        else if (option == "--hit-frame-mult") {
+            float v[1];
+            if ((parsed = ParseFloats(value, v))) {
+                overrides.hitFrameGlobalMult = v[0];
+            }
+        }
+        if (!parsed) {
+            std::fprintf(stderr, "bad option %s %s\n", option.c_str(), value);
+            return 2;
+        }
+        ab = true;
+    }
+
+    const auto file    = ReadFile(argv[1]);
+    const auto records = Core::ReadTelemetry(file);
+    if (records.empty()) {
+        std::fprintf(stderr, "%s is not a paragon telemetry trace or holds no records\n", argv[1]);
+        return 1;
+    }
+
+    std::array<KindStats, kindNames.size()> stats{};
+    const auto                              start = std::chrono::steady_clock::now();
+    for (const auto& record : records) {
+        const auto kind = static_cast<std::size_t>(record.kind);
+        if (kind >= stats.size()) {
+            continue;
+        }
+        auto& kindStats = stats[kind];
+        kindStats.records++;
+
+        float result;
+        if (!Core::ReplayTelemetry(record, overrides, result)) {
+            continue;
+        }
+        kindStats.recorded += record.out;
+        kindStats.replayed += result;
+        if (!ab && std::fabs(result - record.out) > 1e-4f * std::max(1.0f, std::fabs(record.out))) {
+            kindStats.mismatches++;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%zu records, replayed in %.2f ns/record\n\n", records.size(), elapsed / static_cast<double>(records.size()));
+    std::printf("%-22s %10s %12s %12s %10s\n", "formula", "records", ab ? "mean A" : "mean", ab ? "mean B" : "replayed", ab ? "change" : "mismatch");
+
+    std::uint64_t mismatches = 0;
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const auto& kindStats = stats[i];
+        if (!kindStats.records) {
+            continue;
+        }
+        const auto n        = static_cast<double>(kindStats.records);
+        const auto recorded = kindStats.recorded / n;
+        const auto replayed = kindStats.replayed / n;
+        if (i >= static_cast<std::size_t>(Core::TelemetryKind::kHit)) {
+            std::printf("%-22s %10llu\n", kindNames[i], static_cast<unsigned long long>(kindStats.records));
+        }
+        else if (ab) {
+            const auto change = recorded != 0.0 ? (replayed / recorded - 1.0) * 100.0 : 0.0;
+            std::printf("%-22s %10llu %12.3f %12.3f %+9.2f%%\n", kindNames[i], static_cast<unsigned long long>(kindStats.records), recorded, replayed, change);
+        }
+        else {
+            std::printf("%-22s %10llu %12.3f %12.3f %10llu\n", kindNames[i], static_cast<unsigned long long>(kindStats.records), recorded, replayed,
+                        static_cast<unsigned long long>(kindStats.mismatches));
+        }
+        mismatches += kindStats.mismatches;
+    }
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,451 @@
+// paragon-sim: headless combat simulator for the rules in paragon-core. Two armies fight on an open
+// field, every actor follows a scripted attack / block / cast schedule, and every hit goes through
+// the same rule chain the plugin's hooks run: hit dedup, block stamina or parry AoE, pit fighter
+// multiplier (nearby enemies from the spatial grid), armor scaling, plus the per-frame actor update
+// tiers and attack stamina costs.
+//
+//   paragon-sim [--actors 200] [--seconds 60] [--fps 60] [--seed 1] [--expect <checksum>]
+//
+// Reports throughput, heap allocations per simulated frame and time per subsystem. The checksum
+// folds the final state of every actor, with --expect a changed result fails the run (exit 1), so
+// the tool doubles as a regression benchmark for formula and scheduling changes.
+#include "Core/ArmorCurve.h"
+#include "Core/CombatRules.h"
+#include "Core/CycleHistogram.h"
+#include "Core/HitDedupRing.h"
+#include "Core/ParryTargets.h"
+#include "Core/Random.h"
+#include "Core/SpatialGrid.h"
+#include "Core/UpdateTiers.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::uint64_t> allocations{ 0 };
+}
+
+// counts every heap allocation of the simulation, the rules themselves should not make any
+void* operator new(std::size_t a_size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto memory = std::malloc(a_size ? a_size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* a_memory) noexcept
+{
+    std::free(a_memory);
+}
+
+void operator delete(void* a_memory, std::size_t) noexcept
+{
+    std::free(a_memory);
+}
+
+namespace
+{
+    enum class Subsystem : std::uint32_t
+    {
+        kSpatialIndex,
+        kActorUpdate,
+        kAttackStamina,
+        kHitDedup,
+        kBlockStamina,
+        kParry,
+        kPitFighter,
+        kArmorScaling,
+
+        kTotal
+    };
+
+    constexpr std::array<const char*, static_cast<std::size_t>(Subsystem::kTotal)> subsystemNames{
+        "spatial index", "actor update tiers", "attack stamina", "hit dedup", "block stamina", "parry aoe", "pit fighter", "armor scaling",
+    };
+
+    std::array<Core::CycleHistogram, static_cast<std::size_t>(Subsystem::kTotal)> subsystems;
+
+    Core::ScopedCycles Time(Subsystem a_subsystem) noexcept
+    {
+        return Core::ScopedCycles(&subsystems[static_cast<std::size_t>(a_subsystem)]);
+    }
+
+    enum class Action : std::uint8_t
+    {
+        kAttack,
+        kPowerAttack,
+        kBash,
+        kBlock,
+        kCast,
+    };
+
+    // every actor loops over its own rotation, offset by its index so the armies don't act in lockstep
+    constexpr std::array<Action, 8> script{ Action::kAttack, Action::kAttack, Action::kBlock, Action::kPowerAttack,
+                                            Action::kAttack, Action::kBash,   Action::kBlock, Action::kCast };
+
+    struct Actor
+    {
+        float             x, y, z;
+        float             health{ 100.0f };
+        float             stamina{ 100.0f };
+        float             armorRating;
+        float             weaponWeight;
+        float             nextAction;
+        float             blockStart{ -1.0f };
+        float             blockEnd{ -1.0f };
+        std::uint32_t     step;
+        std::uint8_t      team;
+        Core::WeaponClass weaponClass;
+        bool              dualWielding;
+        bool              perks; // block, bash and pit fighter perks
+    };
+
+    // game settings and plugin defaults
+    constexpr Core::BlockStaminaSettings       blockSettings{ 0.6f, 0.2f, 10.0f };
+    constexpr Core::BashStaminaSettings        bashSettings{ 30.0f, 45.0f };
+    constexpr Core::PowerAttackStaminaSettings powerSettings{ 20.0f, 1.0f, 1.0f };
+    constexpr Core::PitFighterModifiers        pitFighter{ 1.15f, 1.3f, 1.5f };
+    constexpr Core::UpdateTierSettings         tierSettings{};
+    constexpr float                            armorScalingFactor = 0.12f;
+    constexpr float                            pitFighterRadius   = 500.0f;
+    constexpr float                            meleeReach         = 150.0f;
+    constexpr float                            spellRange         = 2000.0f;
+    constexpr float                            parryWindow        = 0.2f;
+    constexpr float                            parryRange         = 300.0f;
+
+    class Simulation
+    {
+    public:
+        Simulation(std::uint32_t a_actors, std::uint64_t a_seed) : rng(a_seed)
+        {
+            actors.reserve(a_actors);
+            for (std::uint32_t i = 0; i < a_actors; ++i) {
+                Actor actor{};
+                actor.team         = static_cast<std::uint8_t>(i & 1);
+                actor.x            = rng.UniformFloat(-1500.0f, 1500.0f) + (actor.team ? 400.0f : -400.0f);
+                actor.y            = rng.UniformFloat(-1500.0f, 1500.0f);
+                actor.armorRating  = rng.UniformFloat(50.0f, 1200.0f);
+                actor.weaponWeight = rng.UniformFloat(2.0f, 25.0f);
+                actor.nextAction   = rng.UniformFloat(0.0f, 1.0f);
+                actor.step         = i % script.size();
+                actor.weaponClass  = static_cast<Core::WeaponClass>(rng.UniformInt(0, 4));
+                actor.dualWielding = rng.UniformInt(0, 3) == 0;
+                actor.perks        = i == 0 || rng.UniformInt(0, 4) == 0;
+                actors.push_back(actor);
+            }
+            candidates.reserve(a_actors);
+            candidateIds.reserve(a_actors);
+            selected.reserve(a_actors);
+        }
+
+        void Frame(float a_time, float a_delta)
+        {
+            {
+                auto timer = Time(Subsystem::kSpatialIndex);
+                grid.Clear();
+                for (std::uint32_t i = 0; i < actors.size(); ++i) {
+                    auto& actor = actors[i];
+                    // both armies close in on the middle of the field, then mill around each other
+                    if (std::fabs(actor.x) > 200.0f) {
+                        actor.x -= std::copysign(120.0f * a_delta, actor.x);
+                    }
+                    actor.y += rng.UniformFloat(-30.0f, 30.0f) * a_delta;
+                    if (actor.health > 0.0f) {
+                        grid.Add(actor.x, actor.y, actor.z, i);
+                    }
+                }
+                grid.Build();
+            }
+            {
+                auto         timer  = Time(Subsystem::kActorUpdate);
+                const auto&  player = actors[0];
+                scheduler.BeginFrame();
+                for (std::uint32_t i = 0; i < actors.size(); ++i) {
+                    auto&      actor    = actors[i];
+                    const auto dx       = actor.x - player.x;
+                    const auto dy       = actor.y - player.y;
+                    const auto inCombat = actor.blockEnd > a_time || actor.nextAction - a_time < 0.5f;
+                    const auto tier     = Core::UpdateTierScheduler::Classify(tierSettings, dx * dx + dy * dy, inCombat);
+                    if (scheduler.ShouldService(tierSettings, tier, 0xFF000800 + i, false)) {
+                        actor.stamina = std::min(100.0f, actor.stamina + 5.0f * a_delta);
+                        serviced++;
+                    }
+                }
+            }
+
+            for (std::uint32_t i = 0; i < actors.size(); ++i) {
+                auto& actor = actors[i];
+                if (actor.health <= 0.0f || actor.nextAction > a_time) {
+                    continue;
+                }
+                const auto action = script[actor.step++ % script.size()];
+                actor.nextAction  = a_time + rng.UniformFloat(0.6f, 1.4f);
+                Act(i, action, a_time);
+            }
+        }
+
+        std::uint64_t Checksum() const
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            const auto    fold = [&](float a_value) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &a_value, sizeof(bits));
+                hash = (hash ^ bits) * 0x100000001b3ull;
+            };
+            for (const auto& actor : actors) {
+                fold(actor.health);
+                fold(actor.stamina);
+            }
+            return hash;
+        }
+
+        std::uint64_t hits{ 0 };
+        std::uint64_t duplicates{ 0 };
+        std::uint64_t blocked{ 0 };
+        std::uint64_t parries{ 0 };
+        std::uint64_t staggered{ 0 };
+        std::uint64_t casts{ 0 };
+        std::uint64_t serviced{ 0 };
+
+    private:
+        void Act(std::uint32_t a_index, Action a_action, float a_time)
+        {
+            auto& actor = actors[a_index];
+            if (a_action == Action::kBlock) {
+                actor.blockStart = a_time;
+                actor.blockEnd   = a_time + 1.0f;
+                return;
+            }
+
+            {
+                auto timer = Time(Subsystem::kAttackStamina);
+                switch (a_action) {
+                case Action::kPowerAttack:
+                    actor.stamina -= Core::GetPowerAttackBaseStamina(powerSettings, actor.weaponWeight);
+                    break;
+                case Action::kBash:
+                    actor.stamina -= Core::GetBashStamina(bashSettings, { 1.0f, false, actor.perks });
+                    break;
+                case Action::kAttack:
+                    actor.stamina -= static_cast<float>(Core::GetHitFrameStaminaCost(actor.weaponClass, actor.dualWielding, a_index == 0, 8.0));
+                    break;
+                default:
+                    break;
+                }
+                actor.stamina = std::max(actor.stamina, 0.0f);
+            }
+
+            const auto range  = a_action == Action::kCast ? spellRange : meleeReach;
+            const auto target = NearestEnemy(a_index, range);
+            if (target == noActor) {
+                return;
+            }
+            if (a_action == Action::kCast) {
+                casts++;
+            }
+            Hit(a_index, target, a_action, a_time);
+            // the engine now and then reports the same hit twice
+            if (rng.UniformInt(0, 19) == 0) {
+                Hit(a_index, target, a_action, a_time);
+            }
+        }
+
+        void Hit(std::uint32_t a_attacker, std::uint32_t a_defender, Action a_action, float a_time)
+        {
+            {
+                auto timer = Time(Subsystem::kHitDedup);
+                if (dedup.CheckAndRecord(a_attacker + 1, a_defender + 1, static_cast<std::uint32_t>(a_action),
+                                         static_cast<std::uint32_t>(a_time * 1000.0f), 0)) {
+                    duplicates++;
+                    return;
+                }
+            }
+            hits++;
+
+            auto&      attacker = actors[a_attacker];
+            auto&      defender = actors[a_defender];
+            const bool melee    = a_action != Action::kCast;
+            float      damage   = a_action == Action::kPowerAttack ? 30.0f : 15.0f;
+
+            if (melee && defender.blockEnd > a_time) {
+                blocked++;
+                if (defender.perks && a_time - defender.blockStart < parryWindow) {
+                    Parry(a_defender, a_attacker, a_time);
+                    return;
+                }
+                auto timer = Time(Subsystem::kBlockStamina);
+                defender.stamina = std::max(0.0f, defender.stamina - Core::GetBlockStaminaDamage(blockSettings, { 0.8f, damage, 0.5f, defender.perks }));
+                damage *= 0.2f;
+            }
+
+            if (attacker.perks) {
+                auto       timer   = Time(Subsystem::kPitFighter);
+                const auto enemies = grid.CountWithin(attacker.x, attacker.y, attacker.z, pitFighterRadius, [&](const Grid::Entry& a_entry) {
+                    return actors[a_entry.value].team != attacker.team;
+                });
+                damage *= melee ? Core::GetPitFighterMeleeMult(pitFighter, enemies) : Core::GetPitFighterRangedMult(pitFighter, enemies);
+            }
+            {
+                auto       timer  = Time(Subsystem::kArmorScaling);
+                const auto resist = std::min(armorCurve.Evaluate(defender.armorRating * armorScalingFactor / 100.0f, armorScalingFactor), 0.9f);
+                defender.health -= damage * (1.0f - resist);
+            }
+        }
+
+        void Parry(std::uint32_t a_defender, std::uint32_t a_attacker, float a_time)
+        {
+            auto        timer    = Time(Subsystem::kParry);
+            const auto& defender = actors[a_defender];
+            parries++;
+
+            candidates.clear();
+            candidateIds.clear();
+            grid.ForEachWithin(defender.x, defender.y, defender.z, parryRange, [&](const Grid::Entry& a_entry) {
+                if (a_entry.value == a_defender || a_entry.value == a_attacker) {
+                    return;
+                }
+                const auto& other = actors[a_entry.value];
+                candidates.push_back({ other.x - defender.x, other.y - defender.y, other.team != defender.team, other.health <= 0.0f });
+                candidateIds.push_back(a_entry.value);
+            });
+            Core::SelectParryTargets(candidates, 0.0f, {}, selected);
+
+            actors[a_attacker].nextAction = a_time + 1.5f;
+            for (const auto index : selected) {
+                actors[candidateIds[index]].nextAction = a_time + 1.5f;
+            }
+            staggered += selected.size() + 1;
+        }
+
+        static constexpr std::uint32_t noActor = ~0u;
+
+        std::uint32_t NearestEnemy(std::uint32_t a_index, float a_range) const
+        {
+            const auto&   actor   = actors[a_index];
+            std::uint32_t nearest = noActor;
+            float         best    = a_range * a_range;
+            grid.ForEachWithin(actor.x, actor.y, actor.z, a_range, [&](const Grid::Entry& a_entry) {
+                if (actors[a_entry.value].team == actor.team) {
+                    return;
+                }
+                const auto dx = a_entry.x - actor.x;
+                const auto dy = a_entry.y - actor.y;
+                if (dx * dx + dy * dy <= best) {
+                    best    = dx * dx + dy * dy;
+                    nearest = a_entry.value;
+                }
+            });
+            return nearest;
+        }
+
+        using Grid = Core::SpatialGrid<std::uint32_t>;
+
+        Core::Rng                         rng;
+        std::vector<Actor>                actors;
+        Grid                              grid{ 500.0f };
+        Core::ArmorCurve                  armorCurve; // sArmorCurve default
+        Core::UpdateTierScheduler         scheduler;
+        Core::HitDedupRing<>              dedup;
+        std::vector<Core::ParryCandidate> candidates;
+        std::vector<std::uint32_t>        candidateIds;
+        std::vector<std::uint32_t>        selected;
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::uint32_t actorCount = 200;
+    double        seconds    = 60.0;
+    std::uint32_t fps        = 60;
+    std::uint64_t seed       = 1;
+    std::uint64_t expect     = 0;
+    bool          check      = false;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        const char*       value  = argv[i + 1];
+        if (option == "--actors") {
+            actorCount = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--seconds") {
+            seconds = std::strtod(value, nullptr);
+        }
+        else if (option == "--fps") {
+            fps = std::max(1ul, std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--seed") {
+            seed = std::strtoull(value, nullptr, 10);
+        }
+        else if (option == "--expect") {
+            expect = std::strtoull(value, nullptr, 16);
+            check  = true;
+        }
+        else {
+            std::fprintf(stderr, "usage: paragon-sim [--actors n] [--seconds s] [--fps n] [--seed n] [--expect checksum]\n");
+            return 2;
+        }
+    }
+    if (actorCount < 2) {
+        std::fprintf(stderr, "need at least two actors\n");
+        return 2;
+    }
+
+    Simulation simulation(actorCount, seed);
+    const auto frames = static_cast<std::uint64_t>(seconds * fps);
+    const auto delta  = 1.0f / static_cast<float>(fps);
+
+    // the first second warms up every buffer, allocations after it are steady state ones
+    const auto warmup = std::min<std::uint64_t>(fps, frames);
+    for (std::uint64_t frame = 0; frame < warmup; ++frame) {
+        simulation.Frame(static_cast<float>(frame) * delta, delta);
+    }
+    const auto allocationsBefore = allocations.load();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t frame = warmup; frame < frames; ++frame) {
+        simulation.Frame(static_cast<float>(frame) * delta, delta);
+    }
+    const auto wall        = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto steady      = frames - warmup;
+    const auto allocated   = allocations.load() - allocationsBefore;
+    const auto cyclesPerNs = Core::CalibrateCyclesPerNs();
+
+    std::printf("%u actors, %.0f simulated seconds at %u fps (%llu frames, %.1f simulated s/s)\n", actorCount, seconds, fps,
+                static_cast<unsigned long long>(frames), steady ? steady / static_cast<double>(fps) / wall : 0.0);
+    std::printf("  %-22s %12.0f\n", "frames/s", steady / wall);
+    std::printf("  %-22s %12.0f   (%llu hits, %llu duplicates skipped)\n", "hits/s", simulation.hits / (wall > 0 ? wall : 1.0),
+                static_cast<unsigned long long>(simulation.hits), static_cast<unsigned long long>(simulation.duplicates));
+    std::printf("  %-22s %12llu   (%llu parries staggering %llu, %llu casts)\n", "blocked", static_cast<unsigned long long>(simulation.blocked),
+                static_cast<unsigned long long>(simulation.parries), static_cast<unsigned long long>(simulation.staggered),
+                static_cast<unsigned long long>(simulation.casts));
+    std::printf("  %-22s %12.2f   (%llu after warmup)\n", "allocations/frame", steady ? static_cast<double>(allocated) / steady : 0.0,
+                static_cast<unsigned long long>(allocated));
+    std::printf("  %-22s %12.1f   of %u\n\n", "actors updated/frame", frames ? static_cast<double>(simulation.serviced) / frames : 0.0, actorCount);
+
+    std::printf("  %-22s %12s %12s %12s %12s %10s\n", "subsystem", "calls", "total ms", "mean ns", "p99 ns", "us/frame");
+    for (std::size_t i = 0; i < subsystems.size(); ++i) {
+        const auto summary = subsystems[i].Drain();
+        std::printf("  %-22s %12llu %12.2f %12.1f %12.1f %10.2f\n", subsystemNames[i], static_cast<unsigned long long>(summary.count),
+                    summary.total / cyclesPerNs / 1e6, summary.Mean() / cyclesPerNs, summary.p99 / cyclesPerNs,
+                    summary.total / cyclesPerNs / 1e3 / static_cast<double>(frames));
+    }
+
+    const auto checksum = simulation.Checksum();
+    std::printf("\nchecksum %016llx\n", static_cast<unsigned long long>(checksum));
+    if (check && checksum != expect) {
+        std::printf("expected %016llx, the simulated results changed\n", static_cast<unsigned long long>(expect));
+        return 1;
+    }
+    return 0;
+}
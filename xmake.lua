@@ -2,7 +2,9 @@
 set_xmakever("2.8.2")
 
 -- includes
+if is_plat("windows") then
 includes("lib/commonlibsse-ng")
+end
 
 -- set project
 set_project("paragon-perks")
@@ -22,6 +24,48 @@ add_rules("mode.debug", "mode.releasedbg")
 add_rules("plugin.vsxmake.autoupdate")
 set_config("skse_xbyak", true)
 
+-- engine-agnostic rules, builds on any host
+target("paragon-core")
+set_kind("static")
+add_files("core/src/**.cpp")
+add_headerfiles("core/include/(**.h)")
+add_includedirs("core/include", { public = true })
+
+-- host-side microbenchmarks: xmake build paragon-bench && xmake run paragon-bench [filter]
+target("paragon-bench")
+set_kind("binary")
+set_default(false)
+add_deps("paragon-core")
+add_files("bench/**.cpp")
+add_headerfiles("bench/**.h")
+
+-- pins the core formulas to their shipped values, exits non-zero on a mismatch: xmake run paragon-tests
+target("paragon-tests")
+set_kind("binary")
+set_default(false)
+add_deps("paragon-core")
+add_files("tests/**.cpp")
+target_end()
+
+-- replays a recorded combat trace through the core formulas: xmake run paragon-replay <trace.bin>
+target("paragon-replay")
+set_kind("binary")
+set_default(false)
+add_deps("paragon-core")
+add_files("tools/replay.cpp")
+target_end()
+
+-- headless battle on the core rules, throughput and per subsystem cost: xmake run paragon-sim --actors 200
+target("paragon-sim")
+set_kind("binary")
+set_default(false)
+add_deps("paragon-core")
+add_files("tools/simulate.cpp")
+target_end()
+
+-- the SKSE plugin itself needs CommonLibSSE and only builds on windows
+if is_plat("windows") then
+
 -- packages
 add_requires("simpleini", "xbyak")
 add_requires("spdlog", { configs = { header_only = false } })
@@ -29,7 +73,7 @@ add_requires("spdlog", { configs = { header_only = false } })
 -- targets
 target("paragon-perks")
 -- add dependencies to target
-add_deps("commonlibsse-ng")
+add_deps("commonlibsse-ng", "paragon-core")
 add_packages("fmt", "spdlog", "simpleini", "xbyak")
 
 -- add commonlibsse-ng plugin
@@ -63,3 +107,5 @@ after_build(function(target)
         copy(os.getenv("XSE_TES5_GAME_PATH"), "Data")
     end
 end)
+
+end -- is_plat("windows")